@@ -7,7 +7,7 @@ MOC_DIR = moc
 RCC_DIR = qrc
 OBJECTS_DIR = obj
 
-CONFIG += c++11
+CONFIG += c++17
 
 #-------------------------------------------------------------------------------
 # Qt configuration
@@ -24,6 +24,7 @@ QT += xml
 QT += sql
 QT += svg
 QT += core
+QT += network
 QT += quick
 QT += widgets
 QT += quickcontrols2
@@ -92,15 +93,53 @@ HEADERS += \
     src/AppInfo.h \
     src/Misc/Utilities.h \
     src/Misc/TimerEvents.h \
+    src/Misc/Console.h \
+    src/Misc/Notifications.h \
+    src/Misc/SpscQueue.h \
+    src/Misc/NumberParser.h \
+    src/Misc/StreamBuffer.h \
+    src/Misc/LogWriter.h \
+    src/Misc/SteadyClock.h \
+    src/Misc/LatencyHistogram.h \
+    src/CanSat/CommandQueue.h \
     src/CanSat/ControlPanel.h \
-    src/SerialStudio/Plugin.h
+    src/CanSat/FrameScanner.h \
+    src/CanSat/HeadlessController.h \
+    src/CanSat/IngestionWorker.h \
+    src/CanSat/LatencyTracker.h \
+    src/CanSat/MissionLog.h \
+    src/CanSat/SimulationProfile.h \
+    src/CanSat/SimulationScheduler.h \
+    src/CanSat/Telemetry.h \
+    src/CanSat/TelemetryDecoder.h \
+    src/CanSat/TelemetryHistory.h \
+    src/XBee/FrameBuilder.h \
+    src/XBee/FrameDecoder.h \
+    src/SerialStudio/Plugin.h \
+    src/SerialStudio/JsonFramer.h
 
 SOURCES += \
     src/SerialStudio/Plugin.cpp \
+    src/SerialStudio/JsonFramer.cpp \
     src/main.cpp \
     src/Misc/Utilities.cpp \
     src/Misc/TimerEvents.cpp \
-    src/CanSat/ControlPanel.cpp
+    src/Misc/Console.cpp \
+    src/Misc/Notifications.cpp \
+    src/Misc/LogWriter.cpp \
+    src/Misc/LatencyHistogram.cpp \
+    src/CanSat/CommandQueue.cpp \
+    src/CanSat/ControlPanel.cpp \
+    src/CanSat/FrameScanner.cpp \
+    src/CanSat/HeadlessController.cpp \
+    src/CanSat/IngestionWorker.cpp \
+    src/CanSat/LatencyTracker.cpp \
+    src/CanSat/MissionLog.cpp \
+    src/CanSat/SimulationProfile.cpp \
+    src/CanSat/SimulationScheduler.cpp \
+    src/CanSat/TelemetryDecoder.cpp \
+    src/XBee/FrameBuilder.cpp \
+    src/XBee/FrameDecoder.cpp
 
 #-----------------------------------------------------------------------------------------
 # Deploy files
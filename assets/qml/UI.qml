@@ -24,6 +24,7 @@ import QtQuick
 import QtQuick.Dialogs
 import QtQuick.Layouts
 import QtQuick.Controls
+import QtQuick.Controls.Material
 
 Page {
     id: root
@@ -110,7 +111,7 @@ Page {
 
         Switch {
             Layout.alignment: Qt.AlignVCenter
-            checked: Cpp_SerialStudio_Plugin.isConnected
+            checked: Cpp_CanSat_ControlPanel.serialStudioConnected
 
             MouseArea {
                 anchors.fill: parent
@@ -151,53 +152,89 @@ Page {
             }
         }
 
+        //
+        // Command round-trip & delivery latency
+        //
+        Flow {
+            spacing: 2 * app.spacing
+            Layout.fillWidth: true
+            visible: latencyRepeater.count > 0 || deliveryRepeater.count > 0
+
+            Repeater {
+                id: latencyRepeater
+                model: Cpp_CanSat_ControlPanel.commandLatency
+
+                delegate: Label {
+                    opacity: 0.8
+                    font.pixelSize: 12
+                    font.family: app.monoFont
+                    text: qsTr("%1: p50 %2 ms, p99 %3 ms, max %4 ms (%5)")
+                          .arg(modelData.type).arg(modelData.p50).arg(modelData.p99)
+                          .arg(modelData.max).arg(modelData.count)
+                }
+            }
+
+            Repeater {
+                id: deliveryRepeater
+                model: Cpp_CanSat_ControlPanel.deliveryLatency
+
+                delegate: Label {
+                    opacity: 0.6
+                    font.pixelSize: 12
+                    font.family: app.monoFont
+                    text: qsTr("%1 delivery: p50 %2 ms, p99 %3 ms, max %4 ms (%5)")
+                          .arg(modelData.type).arg(modelData.p50).arg(modelData.p99)
+                          .arg(modelData.max).arg(modelData.count)
+                }
+            }
+        }
+
         //
         // Console display
         //
-        ScrollView {
-            id: scrollView
-            clip: true
+        Rectangle {
+            border.width: 1
+            color: "#aa000000"
             Layout.fillWidth: true
             Layout.fillHeight: true
-            contentWidth: parent.width
-            ScrollBar.horizontal.policy: ScrollBar.AlwaysOff
-
-            TextArea {
-                id: textArea
-                readOnly: true
-                color: "#72d5a3"
-                font.pixelSize: 12
-
-                font.family: app.monoFont
-                textFormat: Text.PlainText
-                width: scrollView.contentWidth
-                wrapMode: Text.WrapAtWordBoundaryOrAnywhere
-                text: qsTr("\n Welcome to the %1 v%2!\n").arg(Cpp_AppName).arg(Cpp_AppVersion) +
-                      qsTr(" Copyright (c) 2023 the Ka'an Sat Team. Released under the MIT License.\n\n")
-
-                Connections {
-                    target: Cpp_CanSat_ControlPanel
-                    function onPrintLn(line) {
-                        textArea.text += " [Control Panel] " + line + "\n"
-                    }
-                }
+            border.color: "#44bebebe"
 
-                Connections {
-                    target: Cpp_SerialStudio_Plugin
-                    function onPrintLn(line) {
-                        textArea.text += " [Serial Studio] " + line + "\n"
-                    }
+            ListView {
+                id: consoleView
+
+                clip: true
+                anchors.fill: parent
+                anchors.margins: 1
+                model: Cpp_Misc_Console
+                boundsBehavior: Flickable.StopAtBounds
+
+                property bool followTail: true
+
+                ScrollBar.vertical: ScrollBar {}
+                onMovementEnded: followTail = atYEnd
+                onCountChanged: {
+                    if (followTail)
+                        positionViewAtEnd()
                 }
 
-                background: Rectangle {
-                    border.width: 1
-                    color: "#aa000000"
-                    border.color: "#44bebebe"
+                header: Label {
+                    color: "#72d5a3"
+                    font.pixelSize: 12
+                    font.family: app.monoFont
+                    width: consoleView.width
+                    textFormat: Text.PlainText
+                    text: qsTr("\n Welcome to the %1 v%2!\n").arg(Cpp_AppName).arg(Cpp_AppVersion) +
+                          qsTr(" Copyright (c) 2023 the Ka'an Sat Team. Released under the MIT License.\n")
                 }
 
-                onTextChanged: {
-                    if (scrollView.contentHeight > scrollView.height)
-                        textArea.cursorPosition = textArea.length - 1
+                delegate: Label {
+                    text: model.line
+                    color: "#72d5a3"
+                    font.pixelSize: 12
+                    font.family: app.monoFont
+                    width: consoleView.width
+                    textFormat: Text.PlainText
+                    wrapMode: Text.WrapAtWordBoundaryOrAnywhere
                 }
             }
         }
@@ -217,7 +254,7 @@ Page {
                 id: simModeEnabled
                 text: qsTr("Simulation mode")
 
-                enabled: Cpp_SerialStudio_Plugin.isConnected
+                enabled: Cpp_CanSat_ControlPanel.serialStudioConnected
                 checked: Cpp_CanSat_ControlPanel.simulationEnabled
                 onClicked: Cpp_CanSat_ControlPanel.simulationEnabled = !Cpp_CanSat_ControlPanel.simulationEnabled
 
@@ -254,7 +291,7 @@ Page {
 
                 text: qsTr("Container telemetry")
 
-                enabled: Cpp_SerialStudio_Plugin.isConnected
+                enabled: Cpp_CanSat_ControlPanel.serialStudioConnected
                 checked: Cpp_CanSat_ControlPanel.containerTelemetryEnabled
                 onClicked: Cpp_CanSat_ControlPanel.containerTelemetryEnabled = !Cpp_CanSat_ControlPanel.containerTelemetryEnabled
 
@@ -273,7 +310,7 @@ Page {
                 id: updateTime
                 text: qsTr("Update container time")
 
-                enabled: Cpp_SerialStudio_Plugin.isConnected
+                enabled: Cpp_CanSat_ControlPanel.serialStudioConnected
                 onClicked: Cpp_CanSat_ControlPanel.updateContainerTime()
 
                 icon.width: 42
@@ -290,7 +327,7 @@ Page {
                 id: updateTimeGPS
                 text: qsTr("Update container time GPS")
 
-                enabled: Cpp_SerialStudio_Plugin.isConnected
+                enabled: Cpp_CanSat_ControlPanel.serialStudioConnected
                 onClicked: Cpp_CanSat_ControlPanel.updateContainerTimeGPS()
 
                 icon.width: 42
@@ -307,7 +344,7 @@ Page {
                 id: calibrateAltitude
                 text: qsTr("Calibrate Altitude to Zero")
 
-                enabled: Cpp_SerialStudio_Plugin.isConnected
+                enabled: Cpp_CanSat_ControlPanel.serialStudioConnected
                 onClicked: Cpp_CanSat_ControlPanel.calibrateAltitude()
 
                 icon.width: 42
@@ -322,4 +359,76 @@ Page {
         }
 
     }
+
+    //
+    // Non-modal notifications
+    //
+    Column {
+        z: 2
+        width: 360
+        spacing: app.spacing
+
+        anchors {
+            right: parent.right
+            bottom: parent.bottom
+            margins: 2 * app.spacing
+        }
+
+        Repeater {
+            model: Cpp_Misc_Notifications
+
+            delegate: Pane {
+                width: parent.width
+                Material.elevation: 6
+                Material.background: model.level === 2 ? "#b71c1c" :
+                                     model.level === 1 ? "#8d5c00" : "#263238"
+
+                //
+                // Informative notifications close automatically
+                //
+                Timer {
+                    interval: 8000
+                    running: model.level === 0
+                    onTriggered: Cpp_Misc_Notifications.dismiss(model.uid)
+                }
+
+                RowLayout {
+                    anchors.fill: parent
+                    spacing: app.spacing
+
+                    ColumnLayout {
+                        spacing: app.spacing / 2
+                        Layout.fillWidth: true
+
+                        Label {
+                            font.bold: true
+                            Layout.fillWidth: true
+                            elide: Label.ElideRight
+                            text: model.count > 1 ? model.title + " (" + model.count + ")" :
+                                                    model.title
+                        }
+
+                        Label {
+                            opacity: 0.8
+                            text: model.text
+                            Layout.fillWidth: true
+                            wrapMode: Label.WrapAtWordBoundaryOrAnywhere
+                        }
+
+                        Label {
+                            opacity: 0.6
+                            font.pixelSize: 10
+                            text: model.time
+                        }
+                    }
+
+                    ToolButton {
+                        text: "✕"
+                        Layout.alignment: Qt.AlignTop
+                        onClicked: Cpp_Misc_Notifications.dismiss(model.uid)
+                    }
+                }
+            }
+        }
+    }
 }
@@ -3,10 +3,13 @@
 
 #include "qtcsv/qtcsv_global.h"
 #include "abstractdata.h"
+#include <QByteArray>
+#include <QByteArrayView>
 #include <QIODevice>
 #include <QList>
 #include <QString>
 #include <QStringConverter>
+#include <QStringView>
 
 namespace QtCSV {
 
@@ -26,7 +29,9 @@ namespace QtCSV {
     // - QList<QList<QString>>, where each QList<QString> contains values
     // of one row;
     // - AbstractData-based container class;
-    // - AbstractProcessor-based object.
+    // - AbstractProcessor-based object;
+    // - AbstractViewProcessor-based object;
+    // - AbstractUtf8Processor-based object.
     class QTCSVSHARED_EXPORT Reader {
     public:
         // AbstractProcessor is a class that could be used to process csv-data
@@ -51,6 +56,66 @@ namespace QtCSV {
             virtual bool processRowElements(const QList<QString>& elements) = 0;
         };
 
+        // AbstractViewProcessor is a class that could be used to process
+        // csv-data line by line without creating a string for each element.
+        // Elements are passed as views into the internal buffers of the reader,
+        // they are valid only during the call of processRowViews().
+        class QTCSVSHARED_EXPORT AbstractViewProcessor
+        {
+        public:
+            virtual ~AbstractViewProcessor() = default;
+
+            // Check if processor wants to preprocess raw lines. If it returns
+            // False, preProcessRawLine() is not called and reader does not
+            // need editable lines.
+            virtual bool preProcessesRawLines() const { return false; }
+
+            // Preprocess one raw line from a file
+            // @input:
+            // editable_line - raw line from a file
+            virtual void preProcessRawLine(QString& /*editable_line*/) {}
+
+            // Process one row worth of elements
+            // @input:
+            // - elements - list of views of row elements
+            // @output:
+            // bool - True if elements was processed successfully, False in case
+            // of error. If process() return False, the csv-file will be stopped
+            // reading
+            virtual bool processRowViews(const QList<QStringView>& elements) = 0;
+        };
+
+        // AbstractUtf8Processor is a class that could be used to process
+        // UTF-8 encoded csv-data line by line. Data is not decoded by reader:
+        // elements are passed as views of raw bytes, so processor could decode
+        // (QString::fromUtf8()) only elements that it needs. Views are valid
+        // only during the call of processRowUtf8().
+        // Only ASCII spaces are trimmed from the elements.
+        class QTCSVSHARED_EXPORT AbstractUtf8Processor
+        {
+        public:
+            virtual ~AbstractUtf8Processor() = default;
+
+            // Check if processor wants to preprocess raw lines. If it returns
+            // False, preProcessRawLine() is not called and lines are not
+            // copied.
+            virtual bool preProcessesRawLines() const { return false; }
+
+            // Preprocess one raw line from a file
+            // @input:
+            // editable_line - raw line from a file
+            virtual void preProcessRawLine(QByteArray& /*editable_line*/) {}
+
+            // Process one row worth of elements
+            // @input:
+            // - elements - list of views of UTF-8 encoded row elements
+            // @output:
+            // bool - True if elements was processed successfully, False in case
+            // of error. If process() return False, the csv-file will be stopped
+            // reading
+            virtual bool processRowUtf8(const QList<QByteArrayView>& elements) = 0;
+        };
+
         // Read csv-file and save it's data as strings to QList<QList<QString>>
         static QList<QList<QString>> readToList(
             const QString& filePath,
@@ -99,6 +164,39 @@ namespace QtCSV {
             const QString& separator = QString(","),
             const QString& textDelimiter = QString("\""),
             QStringConverter::Encoding codec = QStringConverter::Utf8);
+
+        // Read csv-file and process it line-by-line as views of elements
+        static bool readToProcessor(
+            const QString& filePath,
+            AbstractViewProcessor& processor,
+            const QString& separator = QString(","),
+            const QString& textDelimiter = QString("\""),
+            QStringConverter::Encoding codec = QStringConverter::Utf8);
+
+        // Read csv-formatted data from IO Device and process it line-by-line
+        // as views of elements
+        static bool readToProcessor(
+            QIODevice& ioDevice,
+            AbstractViewProcessor& processor,
+            const QString& separator = QString(","),
+            const QString& textDelimiter = QString("\""),
+            QStringConverter::Encoding codec = QStringConverter::Utf8);
+
+        // Read UTF-8 encoded csv-file and process it line-by-line as views of
+        // raw elements
+        static bool readToProcessor(
+            const QString& filePath,
+            AbstractUtf8Processor& processor,
+            const QString& separator = QString(","),
+            const QString& textDelimiter = QString("\""));
+
+        // Read UTF-8 encoded csv-formatted data from IO Device and process it
+        // line-by-line as views of raw elements
+        static bool readToProcessor(
+            QIODevice& ioDevice,
+            AbstractUtf8Processor& processor,
+            const QString& separator = QString(","),
+            const QString& textDelimiter = QString("\""));
     };
 }
 
@@ -10,7 +10,8 @@ SOURCES += \
     $$PWD/sources/variantdata.cpp \
     $$PWD/sources/stringdata.cpp \
     $$PWD/sources/reader.cpp \
-    $$PWD/sources/contentiterator.cpp
+    $$PWD/sources/contentiterator.cpp \
+    $$PWD/sources/scanner.cpp
 
 HEADERS += \
     $$PWD/include/qtcsv/qtcsv_global.h \
@@ -21,4 +22,6 @@ HEADERS += \
     $$PWD/include/qtcsv/abstractdata.h \
     $$PWD/sources/filechecker.h \
     $$PWD/sources/contentiterator.h \
-    $$PWD/sources/symbols.h
+    $$PWD/sources/scanner.h \
+    $$PWD/sources/symbols.h \
+    $$PWD/sources/tokenizer.h
@@ -1,11 +1,18 @@
 #include "include/qtcsv/reader.h"
 #include "include/qtcsv/abstractdata.h"
 #include "sources/filechecker.h"
-#include "sources/symbols.h"
+#include "sources/tokenizer.h"
 #include <QDebug>
 #include <QFile>
+#include <QStringDecoder>
 #include <QStringView>
 #include <QTextStream>
+#include <algorithm>
+#include <cstring>
+
+#ifdef Q_OS_UNIX
+#include <sys/mman.h>
+#endif
 
 using namespace QtCSV;
 
@@ -24,56 +31,109 @@ bool openFile(const QString& filePath, QFile& file) {
     return result;
 }
 
-// ElementInfo is a helper struct that is used as indicator of row end
-struct ElementInfo {
-    bool isEnded = true;
-};
+// Tokenizer of lines of QString
+using StringTokenizer = Tokenizer<QChar, QStringView, QString>;
+
+// Tokenizer of lines of UTF-8 encoded bytes
+using Utf8Tokenizer = Tokenizer<char, QByteArrayView, QByteArray>;
+
+// Size of the chunk of data that is read from IO Device (or decoded from
+// the mapped file) at once
+const qsizetype CHUNK_SIZE = 64 * 1024;
+
+// UTF-8 byte order mark
+const QByteArrayView UTF8_BOM("\xEF\xBB\xBF");
 
 class ReaderPrivate {
     // Check if file path and separator are valid
     static bool checkParams(const QString& separator);
 
-    // Split string to elements
-    static QList<QString> splitElements(
-       const QString& line,
-       const QString& separator,
-       const QString& textDelimiter,
-       ElementInfo& elemInfo);
-
-    // Try to find end position of first or middle element
-    static qsizetype findMiddleElementPosition(
-        const QString& str,
-        const qsizetype& startPos,
+    // Open IO Device if it was not opened
+    static bool openDevice(QIODevice& ioDevice);
+
+    // Map opened file into memory
+    static uchar* mapFile(QFile& file);
+
+    // Transfer row elements to the processor
+    static bool processRow(
+        Reader::AbstractViewProcessor& processor,
+        const QList<QStringView>& elements);
+
+    static bool processRow(
+        Reader::AbstractUtf8Processor& processor,
+        const QList<QByteArrayView>& elements);
+
+    // Tokenize lines of data and transfer rows to processor
+    template <typename Char, typename View, typename Buffer, typename Processor>
+    static qsizetype tokenizeLines(
+        const Char* data,
+        qsizetype size,
+        bool isLastChunk,
+        Tokenizer<Char, View, Buffer>& tokenizer,
+        Processor& processor,
+        Buffer& line,
+        bool& isStopped);
+
+    // Read csv-data from the memory and transfer it's data to
+    // AbstractViewProcessor-based processor
+    static bool readMapped(
+        const char* data,
+        qsizetype size,
+        Reader::AbstractViewProcessor& processor,
         const QString& separator,
-        const QString& txtDelim);
+        const QString& textDelimiter,
+        QStringConverter::Encoding codec);
 
-    // Check if current element is the last element
-    static bool isElementLast(
-        const QString& str,
-        const qsizetype startPos,
+    // Read UTF-8 encoded csv-data from the memory and transfer it's data to
+    // AbstractUtf8Processor-based processor
+    static bool readUtf8Mapped(
+        const char* data,
+        qsizetype size,
+        Reader::AbstractUtf8Processor& processor,
         const QString& separator,
-        const QString& txtDelim);
-
-    // Remove extra symbols (spaces, text delimeters...)
-    static void removeExtraSymbols(
-        QList<QString>& elements, const QString& textDelimiter);
+        const QString& textDelimiter);
 
 public:
     // Function that really reads csv-data and transfer it's data to
-    // AbstractProcessor-based processor
+    // AbstractViewProcessor-based processor
     static bool read(
         QIODevice& ioDevice,
-        Reader::AbstractProcessor& processor,
+        Reader::AbstractViewProcessor& processor,
         const QString& separator,
         const QString& textDelimiter,
         QStringConverter::Encoding codec);
+
+    // Function that really reads UTF-8 encoded csv-data and transfer it's data
+    // to AbstractUtf8Processor-based processor
+    static bool readUtf8(
+        QIODevice& ioDevice,
+        Reader::AbstractUtf8Processor& processor,
+        const QString& separator,
+        const QString& textDelimiter);
+
+    // Read opened csv-file, mapping it into memory if possible, and transfer
+    // it's data to AbstractViewProcessor-based processor
+    static bool readFile(
+        QFile& file,
+        Reader::AbstractViewProcessor& processor,
+        const QString& separator,
+        const QString& textDelimiter,
+        QStringConverter::Encoding codec);
+
+    // Read opened UTF-8 encoded csv-file, mapping it into memory if possible,
+    // and transfer it's data to AbstractUtf8Processor-based processor
+    static bool readFile(
+        QFile& file,
+        Reader::AbstractUtf8Processor& processor,
+        const QString& separator,
+        const QString& textDelimiter);
 };
 
 // Function that really reads csv-data and transfer it's data to
-// AbstractProcessor-based processor
+// AbstractViewProcessor-based processor
 // @input:
 // - ioDevice - IO Device containing the csv-formatted data
-// - processor - refernce to AbstractProcessor-based object
+// - processor - refernce to AbstractViewProcessor-based object
 // - separator - string or character that separate values in a row
 // - textDelimiter - string or character that enclose row elements
 // - codec - pointer to codec object that would be used for file reading
@@ -81,75 +141,40 @@ public:
 // - bool - result of read operation
 bool ReaderPrivate::read(
     QIODevice& ioDevice,
-    Reader::AbstractProcessor& processor,
+    Reader::AbstractViewProcessor& processor,
     const QString& separator,
     const QString& textDelimiter,
     const QStringConverter::Encoding codec)
 {
-    if (!checkParams(separator)) { return false; }
-
-    // Open IO Device if it was not opened
-    if (!ioDevice.isOpen() && !ioDevice.open(QIODevice::ReadOnly)) {
-        qDebug() << __FUNCTION__ << "Error - failed to open IO Device";
-        return false;
-    }
+    if (!checkParams(separator) || !openDevice(ioDevice)) { return false; }
 
     QTextStream stream(&ioDevice);
     stream.setEncoding(codec);
 
-    // This list will contain elements of the row if its elements
-    // are located on several lines
-    QList<QString> row;
-
-    ElementInfo elemInfo;
-    auto result = true;
+    // Tokenizer keeps elements of the row if they are located on several
+    // lines, so each line is walked only once. Line buffer is reused for all
+    // lines of the data.
+    StringTokenizer tokenizer(separator, textDelimiter);
+    const auto preProcess = processor.preProcessesRawLines();
+    QString line;
     while (!stream.atEnd()) {
-        auto line = stream.readLine();
-        processor.preProcessRawLine(line);
-        auto elements = ReaderPrivate::splitElements(
-            line, separator, textDelimiter, elemInfo);
-        if (elemInfo.isEnded) {
-            // Current row ends on this line. Check if these elements are
-            // end elements of the long row
-            if (row.isEmpty()) {
-                // No, these elements constitute the entire row
-                if (!processor.processRowElements(elements)) {
-                    result = false;
-                    break;
-                }
-            }
-            else {
-                // Yes, these elements should be added to the row
-                if (!elements.isEmpty()) {
-                    row.last().append(elements.takeFirst());
-                    row << elements;
-                }
-
-                if (!processor.processRowElements(row)) {
-                    result = false;
-                    break;
-                }
-
-                row.clear();
-            }
-        }
-        else {
-            // These elements constitute long row that lasts on several lines
-            if (!elements.isEmpty()) {
-                if (!row.isEmpty()) {
-                    row.last().append(elements.takeFirst());
-                }
-
-                row << elements;
-            }
+        stream.readLineInto(&line);
+        if (preProcess) { processor.preProcessRawLine(line); }
+
+        if (!tokenizer.tokenizeLine(line.constData(), line.size())) {
+            // Row continues on the next line
+            continue;
         }
+
+        if (!processor.processRowViews(tokenizer.elements())) { return false; }
     }
 
-    if (!elemInfo.isEnded && !row.isEmpty()) {
-        result = processor.processRowElements(row);
+    // Data ended inside of the quoted element
+    if (tokenizer.finishRow()) {
+        return processor.processRowViews(tokenizer.elements());
     }
 
-    return result;
+    return true;
 }
 
 // Check if file path and separator are valid
@@ -166,304 +191,390 @@ bool ReaderPrivate::checkParams(const QString& separator) {
     return true;
 }
 
-// Split string to elements
+// Open IO Device if it was not opened
 // @input:
-// - line - string with data
-// - separator - string or character that separate elements
-// - textDelimiter - string that is used as text delimiter
+// - ioDevice - IO Device containing the csv-formatted data
 // @output:
-// - QList<QString> - list of elements
-QList<QString> ReaderPrivate::splitElements(
-    const QString& line,
-    const QString& separator,
-    const QString& textDelimiter,
-    ElementInfo& elemInfo)
-{
-    // If separator is empty, return whole line. Can't work in this
-    // conditions!
-    if (separator.isEmpty()) {
-        elemInfo.isEnded = true;
-        return (QList<QString>() << line);
+// - bool - True if IO Device is opened, otherwise False
+bool ReaderPrivate::openDevice(QIODevice& ioDevice) {
+    if (!ioDevice.isOpen() && !ioDevice.open(QIODevice::ReadOnly)) {
+        qDebug() << __FUNCTION__ << "Error - failed to open IO Device";
+        return false;
     }
 
-    if (line.isEmpty()) {
-        // If previous row was ended, then return empty QList<QString>.
-        // Otherwise return list that contains one element - new line symbols
-        return elemInfo.isEnded ? QList<QString>() : (QList<QString>() << LF);
-    }
+    return true;
+}
 
-    QList<QString> result;
-    qsizetype pos = 0;
-    while (pos < line.size()) {
-        if (elemInfo.isEnded) {
-            // This line is a new line, not a continuation of the previous
-            // line.
-            // Check if element starts with the delimiter symbol
-            const auto delimiterPos = line.indexOf(textDelimiter, pos);
-            if (delimiterPos == pos) {
-                pos = delimiterPos + textDelimiter.size();
-
-                // Element starts with the delimiter symbol. It means that
-                // this element could contain any number of double
-                // delimiters and separator symbols. This element could:
-                // 1. Be the first or the middle element. Then it should end
-                // with delimiter and the seprator symbols standing next to each
-                // other.
-                const auto midElemEndPos = findMiddleElementPosition(
-                    line, pos, separator, textDelimiter);
-                if (midElemEndPos > 0) {
-                    const auto length = midElemEndPos - pos;
-                    result << line.mid(pos, length);
-                    pos =
-                        midElemEndPos + textDelimiter.size() + separator.size();
-                    continue;
-                }
-
-                // 2. Be The last element on the line. Then it should end with
-                // delimiter symbol.
-                if (isElementLast(line, pos, separator, textDelimiter)) {
-                    const auto length = line.size() - textDelimiter.size() - pos;
-                    result << line.mid(pos, length);
-                    break;
-                }
-
-                // 3. Not ends on this line
-                const auto length = line.size() - pos;
-                result << line.mid(pos, length);
-                elemInfo.isEnded = false;
-                break;
-            }
-            else {
-                // Element do not starts with the delimiter symbol. It means
-                // that this element do not contain double delimiters and it
-                // ends at the next separator symbol.
-                // Check if line contains separator symbol.
-                const auto separatorPos = line.indexOf(separator, pos);
-                if (separatorPos >= 0) {
-                    // If line contains separator symbol, then our element
-                    // located between current position and separator
-                    // position. Copy it into result list and move
-                    // current position over the separator position.
-                    result << line.mid(pos, separatorPos - pos);
-
-                    // Special case: if line ends with separator symbol,
-                    // then at the end of the line we have empty element.
-                    if (separatorPos == line.size() - separator.size()) {
-                        result << QString();
-                    }
-
-                    // Move the current position on to the next element
-                    pos = separatorPos + separator.size();
-                }
-                else {
-                    // If line do not contains separator symbol, then
-                    // this element ends at the end of the string.
-                    // Copy it into result list and exit the loop.
-                    result << line.mid(pos);
-                    break;
-                }
-            }
+// Function that really reads UTF-8 encoded csv-data and transfer it's data to
+// AbstractUtf8Processor-based processor. Data is read by chunks and tokenized
+// in place, without decoding.
+// @input:
+// - ioDevice - IO Device containing the csv-formatted data
+// - processor - refernce to AbstractUtf8Processor-based object
+// - separator - string or character that separate values in a row
+// - textDelimiter - string or character that enclose row elements
+// @output:
+// - bool - result of read operation
+bool ReaderPrivate::readUtf8(
+    QIODevice& ioDevice,
+    Reader::AbstractUtf8Processor& processor,
+    const QString& separator,
+    const QString& textDelimiter)
+{
+    if (!checkParams(separator) || !openDevice(ioDevice)) { return false; }
+
+    Utf8Tokenizer tokenizer(separator.toUtf8(), textDelimiter.toUtf8());
+    QByteArray chunk(CHUNK_SIZE, Qt::Uninitialized);
+    QByteArray line;
+    qsizetype chunkSize = 0;
+    auto isFirstChunk = true;
+    auto isStopped = false;
+    while (true) {
+        // Line does not fit into the chunk, so make the chunk bigger
+        if (chunkSize == chunk.size()) { chunk.resize(chunk.size() * 2); }
+
+        const auto bytesRead = ioDevice.read(
+            chunk.data() + chunkSize, chunk.size() - chunkSize);
+        if (bytesRead < 0) {
+            qDebug() << __FUNCTION__ << "Error - failed to read IO Device";
+            return false;
         }
-        else
-        {
-            // This line is a continuation of the previous. Last element of the
-            // previous line did not end. It started with delimiter symbol.
-            // It means that this element could contain any number of double
-            // delimiters and separator symbols. This element could:
-            // 1. Ends somewhere in the middle of the line. Then it should ends
-            // with delimiter and the seprator symbols standing next to each
-            // other.
-            const auto midElemEndPos = findMiddleElementPosition(
-                line, pos, separator, textDelimiter);
-            if (midElemEndPos >= 0) {
-                result << (LF + line.mid(pos, midElemEndPos - pos));
-                pos = midElemEndPos + textDelimiter.size() + separator.size();
-                elemInfo.isEnded = true;
-                continue;
-            }
-
-            // 2. Ends at the end of the line. Then it should ends with
-            // delimiter symbol.
-            if (isElementLast(line, pos, separator, textDelimiter)) {
-                const auto length = line.size() - textDelimiter.size() - pos;
-                result << (LF + line.mid(pos, length));
-                elemInfo.isEnded = true;
-                break;
-            }
-
-            // 3. Not ends on this line
-            result << (LF + line);
-            break;
+
+        chunkSize += bytesRead;
+        const auto isLastChunk = bytesRead == 0;
+
+        // Skip byte order mark. Wait for enough data to check it.
+        qsizetype start = 0;
+        if (isFirstChunk) {
+            if (chunkSize < UTF8_BOM.size() && !isLastChunk) { continue; }
+
+            isFirstChunk = false;
+            const QByteArrayView chunkView(chunk.constData(), chunkSize);
+            if (chunkView.startsWith(UTF8_BOM)) { start = UTF8_BOM.size(); }
         }
+
+        const auto consumed = tokenizeLines(
+            chunk.constData() + start, chunkSize - start, isLastChunk,
+            tokenizer, processor, line, isStopped);
+        if (isStopped) { return false; }
+        if (isLastChunk) { break; }
+
+        // Move the unfinished line to the beginning of the chunk
+        chunkSize -= start + consumed;
+        std::memmove(chunk.data(), chunk.constData() + start + consumed,
+                     static_cast<size_t>(chunkSize));
     }
 
-    removeExtraSymbols(result, textDelimiter);
+    // Data ended inside of the quoted element
+    if (tokenizer.finishRow()) {
+        return processor.processRowUtf8(tokenizer.elements());
+    }
+
+    return true;
+}
+
+// Read opened csv-file and transfer it's data to AbstractViewProcessor-based
+// processor. File is mapped into memory and decoded by chunks. If file could
+// not be mapped, it is read as IO Device.
+// @input:
+// - file - opened file
+// - processor - refernce to AbstractViewProcessor-based object
+// - separator - string or character that separate values in a row
+// - textDelimiter - string or character that enclose row elements
+// - codec - pointer to codec object that would be used for file reading
+// @output:
+// - bool - result of read operation
+bool ReaderPrivate::readFile(
+    QFile& file,
+    Reader::AbstractViewProcessor& processor,
+    const QString& separator,
+    const QString& textDelimiter,
+    const QStringConverter::Encoding codec)
+{
+    auto* data = mapFile(file);
+    if (!data) { return read(file, processor, separator, textDelimiter, codec); }
+
+    const auto result = readMapped(
+        reinterpret_cast<const char*>(data), file.size(),
+        processor, separator, textDelimiter, codec);
+    file.unmap(data);
     return result;
 }
 
-// Try to find end position of first or middle element
+// Read opened UTF-8 encoded csv-file and transfer it's data to
+// AbstractUtf8Processor-based processor. File is mapped into memory and
+// tokenized in place. If file could not be mapped, it is read as IO Device.
 // @input:
-// - str - string with data
-// - startPos - start position of the current element in the string
-// - separator - string or character that separate elements
-// - textDelimiter - string that is used as text delimiter
+// - file - opened file
+// - processor - refernce to AbstractUtf8Processor-based object
+// - separator - string or character that separate values in a row
+// - textDelimiter - string or character that enclose row elements
 // @output:
-// - qsizetype - end position of the element or -1 if this element is not first
-// or middle
-qsizetype ReaderPrivate::findMiddleElementPosition(
-    const QString& str,
-    const qsizetype& startPos,
+// - bool - result of read operation
+bool ReaderPrivate::readFile(
+    QFile& file,
+    Reader::AbstractUtf8Processor& processor,
     const QString& separator,
-    const QString& txtDelim)
+    const QString& textDelimiter)
 {
-    const qsizetype ERROR = -1;
-    if (str.isEmpty() ||
-        startPos < 0 ||
-        separator.isEmpty() ||
-        txtDelim.isEmpty())
-    {
-        return ERROR;
-    }
+    auto* data = mapFile(file);
+    if (!data) { return readUtf8(file, processor, separator, textDelimiter); }
 
-    const auto elemEndSymbols = txtDelim + separator;
-    auto elemEndPos = startPos;
-    while (elemEndPos < str.size()) {
-        // Find position of element end symbol
-        elemEndPos = str.indexOf(elemEndSymbols, elemEndPos);
-        if (elemEndPos < 0) {
-            // This element could not be the middle element, becaise string
-            // do not contains any end symbols
-            return ERROR;
-        }
+    const auto result = readUtf8Mapped(
+        reinterpret_cast<const char*>(data), file.size(),
+        processor, separator, textDelimiter);
+    file.unmap(data);
+    return result;
+}
 
-        // Check that this is really the end symbols of the
-        // element and we don't mix up it with double delimiter
-        // and separator. Calc number of delimiter symbols from elemEndPos
-        // to startPos that stands together.
-        qsizetype numOfDelimiters = 0;
-        for (auto pos = elemEndPos; startPos <= pos; --pos, ++numOfDelimiters) {
-            const auto strRef = str.mid(pos, txtDelim.size());
-            if (QString::compare(strRef, txtDelim) != 0) { break; }
-        }
+// Map opened file into memory
+// @input:
+// - file - opened file
+// @output:
+// - uchar* - pointer to the file data or nullptr if file could not be
+// mapped (empty file, sequential device...)
+uchar* ReaderPrivate::mapFile(QFile& file) {
+    const auto size = file.size();
+    if (size <= 0 || file.isSequential()) { return nullptr; }
 
-        // If we have odd number of delimiter symbols that stand together,
-        // then this is the even number of double delimiter symbols + last
-        // delimiter symbol. That means that we have found end position of
-        // the middle element.
-        if (numOfDelimiters % 2 == 1) {
-            return elemEndPos;
-        }
-        else {
-            // Otherwise this is not the end of the middle element and we
-            // should try again
-            elemEndPos += elemEndSymbols.size();
-        }
-    }
+    auto* data = file.map(0, size);
+    if (!data) { return nullptr; }
 
-    return ERROR;
+#ifdef Q_OS_UNIX
+    // File is read once from the beginning to the end
+    madvise(data, static_cast<size_t>(size), MADV_SEQUENTIAL);
+#endif
+
+    return data;
 }
 
-// Check if current element is the last element
+// Read csv-data from the memory and transfer it's data to
+// AbstractViewProcessor-based processor. Data is decoded by chunks, like
+// QTextStream does: byte order mark selects the encoding and is skipped.
 // @input:
-// - str - string with data
-// - startPos - start position of the current element in the string
-// - separator - string or character that separate elements
-// - textDelimiter - string that is used as text delimiter
+// - data - pointer to the data
+// - size - size of the data
+// - processor - refernce to AbstractViewProcessor-based object
+// - separator - string or character that separate values in a row
+// - textDelimiter - string or character that enclose row elements
+// - codec - pointer to codec object that would be used for data decoding
 // @output:
-// - bool - True if the current element is the last element of the string,
-// False otherwise
-bool ReaderPrivate::isElementLast(
-    const QString& str,
-    const qsizetype startPos,
+// - bool - result of read operation
+bool ReaderPrivate::readMapped(
+    const char* data,
+    const qsizetype size,
+    Reader::AbstractViewProcessor& processor,
     const QString& separator,
-    const QString& txtDelim)
+    const QString& textDelimiter,
+    const QStringConverter::Encoding codec)
 {
-    if (str.isEmpty() ||
-        startPos < 0 ||
-        separator.isEmpty() ||
-        txtDelim.isEmpty())
-    {
-        return false;
+    if (!checkParams(separator)) { return false; }
+
+    const auto bomEncoding = QStringConverter::encodingForData(
+        QByteArrayView(data, size));
+    QStringDecoder decoder(bomEncoding ? *bomEncoding : codec);
+
+    StringTokenizer tokenizer(separator, textDelimiter);
+    QString text;
+    QString line;
+    qsizetype textSize = 0;
+    auto isStopped = false;
+    for (qsizetype offset = 0; offset < size; offset += CHUNK_SIZE) {
+        const auto chunkSize = qMin(CHUNK_SIZE, size - offset);
+        const auto isLastChunk = offset + chunkSize >= size;
+
+        // Decode the chunk after the unfinished line of the previous chunk
+        text.resize(textSize + decoder.requiredSpace(chunkSize));
+        const auto* textEnd = decoder.appendToBuffer(
+            text.data() + textSize, QByteArrayView(data + offset, chunkSize));
+        textSize = textEnd - text.constData();
+
+        const auto consumed = tokenizeLines(
+            text.constData(), textSize, isLastChunk,
+            tokenizer, processor, line, isStopped);
+        if (isStopped) { return false; }
+
+        // Move the unfinished line to the beginning of the text
+        textSize -= consumed;
+        std::copy(text.constData() + consumed,
+                  text.constData() + consumed + textSize, text.data());
     }
 
-    // Check if string ends with text delimiter. If not, then this element
-    // do not ends on this line
-    if (!str.endsWith(txtDelim)) { return false; }
-
-    // Check that this is really the end symbols of the
-    // element and we don't mix up it with double delimiter.
-    // Calc number of delimiter symbols from end
-    // to startPos that stands together.
-    qsizetype numOfDelimiters = 0;
-    for (auto pos = str.size() - 1; startPos <= pos; --pos, ++numOfDelimiters) {
-        const auto strRef = str.mid(pos, txtDelim.size());
-        if (QString::compare(strRef, txtDelim) != 0) { break; }
+    // Data ended inside of the quoted element
+    if (tokenizer.finishRow()) {
+        return processor.processRowViews(tokenizer.elements());
+    }
+
+    return true;
+}
+
+// Read UTF-8 encoded csv-data from the memory and transfer it's data to
+// AbstractUtf8Processor-based processor. Data is tokenized in place.
+// @input:
+// - data - pointer to the data
+// - size - size of the data
+// - processor - refernce to AbstractUtf8Processor-based object
+// - separator - string or character that separate values in a row
+// - textDelimiter - string or character that enclose row elements
+// @output:
+// - bool - result of read operation
+bool ReaderPrivate::readUtf8Mapped(
+    const char* data,
+    const qsizetype size,
+    Reader::AbstractUtf8Processor& processor,
+    const QString& separator,
+    const QString& textDelimiter)
+{
+    if (!checkParams(separator)) { return false; }
+
+    // Skip byte order mark
+    const auto start = QByteArrayView(data, size).startsWith(UTF8_BOM) ?
+        UTF8_BOM.size() : 0;
+
+    Utf8Tokenizer tokenizer(separator.toUtf8(), textDelimiter.toUtf8());
+    QByteArray line;
+    auto isStopped = false;
+    tokenizeLines(data + start, size - start, true,
+                  tokenizer, processor, line, isStopped);
+    if (isStopped) { return false; }
+
+    // Data ended inside of the quoted element
+    if (tokenizer.finishRow()) {
+        return processor.processRowUtf8(tokenizer.elements());
     }
 
-    // If we have odd number of delimiter symbols that stand together,
-    // then this is the even number of double delimiter symbols + last
-    // delimiter symbol. That means that this element is the last on the line.
-    return numOfDelimiters % 2 == 1;
+    return true;
 }
 
-// Remove extra symbols (spaces, text delimeters...)
+// Transfer row elements to AbstractViewProcessor-based processor
 // @input:
-// - elements - list of row elements
-// - textDelimiter - string that is used as text delimiter
-void ReaderPrivate::removeExtraSymbols(
-    QList<QString>& elements, const QString& textDelimiter)
+// - processor - refernce to AbstractViewProcessor-based object
+// - elements - views of row elements
+// @output:
+// - bool - result of processing
+bool ReaderPrivate::processRow(
+    Reader::AbstractViewProcessor& processor,
+    const QList<QStringView>& elements)
 {
-    if (elements.isEmpty()) { return; }
-
-    const auto doubleTextDelim = textDelimiter + textDelimiter;
-    for (auto i = 0; i < elements.size(); ++i) {
-        const auto str = QStringView{elements.at(i)};
-        if (str.isEmpty()) { continue; }
-
-        qsizetype startPos = 0, endPos = str.size() - 1;
-
-        // Find first non-space char
-        for (; startPos < str.size() &&
-               str.at(startPos).category() == QChar::Separator_Space;
-             ++startPos);
-
-        // Find last non-space char
-        for (;
-             endPos >= 0 && str.at(endPos).category() == QChar::Separator_Space;
-             --endPos);
-
-        if (!textDelimiter.isEmpty()) {
-            // Skip text delimiter symbol if element starts with it
-            const auto strStart = str.mid(startPos, textDelimiter.size());
-            if (strStart == textDelimiter) {
-                startPos += textDelimiter.size();
-            }
-
-            // Skip text delimiter symbol if element ends with it
-            const auto strEnd = str.mid(
-                endPos - textDelimiter.size() + 1, textDelimiter.size());
-            if (strEnd == textDelimiter) {
-                endPos -= textDelimiter.size();
-            }
+    return processor.processRowViews(elements);
+}
+
+// Transfer row elements to AbstractUtf8Processor-based processor
+// @input:
+// - processor - refernce to AbstractUtf8Processor-based object
+// - elements - views of UTF-8 encoded row elements
+// @output:
+// - bool - result of processing
+bool ReaderPrivate::processRow(
+    Reader::AbstractUtf8Processor& processor,
+    const QList<QByteArrayView>& elements)
+{
+    return processor.processRowUtf8(elements);
+}
+
+// Tokenize lines of data and transfer rows to processor
+// @input:
+// - data - pointer to the data
+// - size - size of the data
+// - isLastChunk - True if there is no more data, then the data after the last
+// line break is the last line
+// - tokenizer - tokenizer that keeps unfinished rows between the chunks
+// - processor - refernce to processor object
+// - line - buffer for lines that should be preprocessed
+// - isStopped - set to True if processor stopped reading
+// @output:
+// - qsizetype - number of symbols of the data that were tokenized
+template <typename Char, typename View, typename Buffer, typename Processor>
+qsizetype ReaderPrivate::tokenizeLines(
+    const Char* data,
+    const qsizetype size,
+    const bool isLastChunk,
+    Tokenizer<Char, View, Buffer>& tokenizer,
+    Processor& processor,
+    Buffer& line,
+    bool& isStopped)
+{
+    const auto preProcess = processor.preProcessesRawLines();
+    const Char lineFeed(u'\n');
+    const Char carriageReturn(u'\r');
+    qsizetype pos = 0;
+    while (pos < size) {
+        const auto lineFeedPos = FindSymbol(data, size, pos, lineFeed);
+        const auto hasLineFeed = lineFeedPos < size;
+        if (!hasLineFeed && !isLastChunk) { break; }
+
+        // Line ends with "\n" or "\r\n", or at the end of the data
+        auto lineSize = lineFeedPos - pos;
+        if (hasLineFeed && lineSize > 0 &&
+            data[lineFeedPos - 1] == carriageReturn)
+        {
+            --lineSize;
+        }
+
+        const auto* lineData = data + pos;
+        pos = hasLineFeed ? lineFeedPos + 1 : size;
+        if (preProcess) {
+            line.resize(0);
+            line.append(lineData, lineSize);
+            processor.preProcessRawLine(line);
+            lineData = line.constData();
+            lineSize = line.size();
         }
 
-        if ((0 < startPos || endPos < str.size() - 1) &&
-            startPos <= endPos) {
-            elements[i] = elements[i].mid(startPos, endPos - startPos + 1);
+        if (!tokenizer.tokenizeLine(lineData, lineSize)) {
+            // Row continues on the next line
+            continue;
         }
 
-        // Also replace double text delimiter with one text delimiter symbol
-        elements[i].replace(doubleTextDelim, textDelimiter);
+        if (!processRow(processor, tokenizer.elements())) {
+            isStopped = true;
+            break;
+        }
     }
+
+    return pos;
 }
 
+// ElementsProcessor - processor that converts views of row elements to
+// strings and transfers them to AbstractProcessor-based processor
+class ElementsProcessor : public Reader::AbstractViewProcessor {
+    Reader::AbstractProcessor& m_processor;
+    QList<QString> m_elements;
+
+public:
+    explicit ElementsProcessor(Reader::AbstractProcessor& processor) :
+        m_processor(processor) {}
+
+    bool preProcessesRawLines() const override { return true; }
+
+    void preProcessRawLine(QString& line) override {
+        m_processor.preProcessRawLine(line);
+    }
+
+    bool processRowViews(const QList<QStringView>& elements) override {
+        m_elements.clear();
+        m_elements.reserve(elements.size());
+        for (const auto& element : elements) {
+            m_elements << element.toString();
+        }
+
+        return m_processor.processRowElements(m_elements);
+    }
+};
+
 // ReadToListProcessor - processor that saves rows of elements to list.
-class ReadToListProcessor : public Reader::AbstractProcessor {
+class ReadToListProcessor : public Reader::AbstractViewProcessor {
 public:
     QList<QList<QString>> data;
 
-    bool processRowElements(const QList<QString>& elements) override {
-        data << elements;
+    bool processRowViews(const QList<QStringView>& elements) override {
+        QList<QString> row;
+        row.reserve(elements.size());
+        for (const auto& element : elements) {
+            row << element.toString();
+        }
+
+        data << row;
         return true;
     }
 };
@@ -484,8 +595,11 @@ QList<QList<QString>> Reader::readToList(
     const QStringConverter::Encoding codec)
 {
     QFile file;
-    return openFile(filePath, file) ?
-        readToList(file, separator, textDelimiter, codec) : QList<QList<QString>>();
+    if (!openFile(filePath, file)) { return QList<QList<QString>>(); }
+
+    ReadToListProcessor processor;
+    ReaderPrivate::readFile(file, processor, separator, textDelimiter, codec);
+    return processor.data;
 }
 
 // Read csv-formatted data from IO Device and save it
@@ -518,8 +632,18 @@ bool Reader::readToData(
     const QStringConverter::Encoding codec)
 {
     QFile file;
-    return openFile(filePath, file) ?
-        readToData(file, data, separator, textDelimiter, codec) : false;
+    if (!openFile(filePath, file)) { return false; }
+
+    ReadToListProcessor processor;
+    const auto result = ReaderPrivate::readFile(
+        file, processor, separator, textDelimiter, codec);
+    if (result) {
+        for (auto i = 0; i < processor.data.size(); ++i) {
+            data.addRow(processor.data.at(i));
+        }
+    }
+
+    return result;
 }
 
 // Read csv-formatted data from IO Device and save it
@@ -561,8 +685,11 @@ bool Reader::readToProcessor(
     const QStringConverter::Encoding codec)
 {
     QFile file;
-    return openFile(filePath, file) ?
-        readToProcessor(file, processor, separator, textDelimiter, codec) : false;
+    if (!openFile(filePath, file)) { return false; }
+
+    ElementsProcessor elementsProcessor(processor);
+    return ReaderPrivate::readFile(
+        file, elementsProcessor, separator, textDelimiter, codec);
 }
 
 // Read csv-formatted data from IO Device and process it line-by-line
@@ -572,7 +699,77 @@ bool Reader::readToProcessor(
     const QString& separator,
     const QString& textDelimiter,
     const QStringConverter::Encoding codec)
+{
+    ElementsProcessor elementsProcessor(processor);
+    return ReaderPrivate::read(
+        ioDevice, elementsProcessor, separator, textDelimiter, codec);
+}
+
+// Read csv-file and process it line-by-line as views of elements
+// @input:
+// - filePath - string with absolute path to csv-file
+// - processor - AbstractViewProcessor-based object that receives data from
+// csv-file line-by-line
+// - separator - string or character that separate elements in a row
+// - textDelimiter - string or character that enclose each element in a row
+// - codec - pointer to codec object that would be used for file reading
+// @output:
+// - bool - True if file was successfully read, otherwise False
+bool Reader::readToProcessor(
+    const QString& filePath,
+    Reader::AbstractViewProcessor& processor,
+    const QString& separator,
+    const QString& textDelimiter,
+    const QStringConverter::Encoding codec)
+{
+    QFile file;
+    return openFile(filePath, file) ?
+        ReaderPrivate::readFile(
+            file, processor, separator, textDelimiter, codec) : false;
+}
+
+// Read csv-formatted data from IO Device and process it line-by-line as views
+// of elements
+bool Reader::readToProcessor(
+    QIODevice& ioDevice,
+    Reader::AbstractViewProcessor& processor,
+    const QString& separator,
+    const QString& textDelimiter,
+    const QStringConverter::Encoding codec)
 {
     return ReaderPrivate::read(
         ioDevice, processor, separator, textDelimiter, codec);
 }
+
+// Read UTF-8 encoded csv-file and process it line-by-line as views of raw
+// elements
+// @input:
+// - filePath - string with absolute path to csv-file
+// - processor - AbstractUtf8Processor-based object that receives data from
+// csv-file line-by-line
+// - separator - string or character that separate elements in a row
+// - textDelimiter - string or character that enclose each element in a row
+// @output:
+// - bool - True if file was successfully read, otherwise False
+bool Reader::readToProcessor(
+    const QString& filePath,
+    Reader::AbstractUtf8Processor& processor,
+    const QString& separator,
+    const QString& textDelimiter)
+{
+    QFile file;
+    return openFile(filePath, file) ?
+        ReaderPrivate::readFile(file, processor, separator, textDelimiter) :
+        false;
+}
+
+// Read UTF-8 encoded csv-formatted data from IO Device and process it
+// line-by-line as views of raw elements
+bool Reader::readToProcessor(
+    QIODevice& ioDevice,
+    Reader::AbstractUtf8Processor& processor,
+    const QString& separator,
+    const QString& textDelimiter)
+{
+    return ReaderPrivate::readUtf8(ioDevice, processor, separator, textDelimiter);
+}
@@ -0,0 +1,164 @@
+#include "sources/scanner.h"
+#include <QtAlgorithms>
+
+#if defined(__SSE2__) || defined(_M_X64) || \
+    (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define QTCSV_SCANNER_SSE2
+#include <emmintrin.h>
+
+// AVX2 version is compiled with target attribute and is selected at runtime
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define QTCSV_SCANNER_AVX2
+#include <immintrin.h>
+#endif
+#endif
+
+using namespace QtCSV;
+
+// Find position of the symbol in the data symbol by symbol
+template <typename Char>
+static qsizetype findScalar(
+    const Char* data, const qsizetype size, qsizetype pos, const Char symbol)
+{
+    for (; pos < size; ++pos) {
+        if (data[pos] == symbol) { return pos; }
+    }
+
+    return size;
+}
+
+#ifdef QTCSV_SCANNER_SSE2
+// Find position of the byte in the data by blocks of 16 bytes
+static qsizetype findSse2(
+    const char* data, const qsizetype size, qsizetype pos, const char symbol)
+{
+    const auto pattern = _mm_set1_epi8(symbol);
+    for (; pos + 16 <= size; pos += 16) {
+        const auto block = _mm_loadu_si128(
+            reinterpret_cast<const __m128i*>(data + pos));
+        const auto mask = static_cast<quint32>(
+            _mm_movemask_epi8(_mm_cmpeq_epi8(block, pattern)));
+        if (mask != 0) { return pos + qCountTrailingZeroBits(mask); }
+    }
+
+    return findScalar(data, size, pos, symbol);
+}
+
+// Find position of the 16-bit symbol in the data by blocks of 8 symbols
+static qsizetype findSse2(
+    const char16_t* data,
+    const qsizetype size,
+    qsizetype pos,
+    const char16_t symbol)
+{
+    const auto pattern = _mm_set1_epi16(static_cast<short>(symbol));
+    for (; pos + 8 <= size; pos += 8) {
+        const auto block = _mm_loadu_si128(
+            reinterpret_cast<const __m128i*>(data + pos));
+        // Each matched symbol sets two bits of the mask
+        const auto mask = static_cast<quint32>(
+            _mm_movemask_epi8(_mm_cmpeq_epi16(block, pattern)));
+        if (mask != 0) { return pos + qCountTrailingZeroBits(mask) / 2; }
+    }
+
+    return findScalar(data, size, pos, symbol);
+}
+#endif
+
+#ifdef QTCSV_SCANNER_AVX2
+// Find position of the byte in the data by blocks of 32 bytes
+__attribute__((target("avx2")))
+static qsizetype findAvx2(
+    const char* data, const qsizetype size, qsizetype pos, const char symbol)
+{
+    const auto pattern = _mm256_set1_epi8(symbol);
+    for (; pos + 32 <= size; pos += 32) {
+        const auto block = _mm256_loadu_si256(
+            reinterpret_cast<const __m256i*>(data + pos));
+        const auto mask = static_cast<quint32>(
+            _mm256_movemask_epi8(_mm256_cmpeq_epi8(block, pattern)));
+        if (mask != 0) { return pos + qCountTrailingZeroBits(mask); }
+    }
+
+    return findSse2(data, size, pos, symbol);
+}
+
+// Find position of the 16-bit symbol in the data by blocks of 16 symbols
+__attribute__((target("avx2")))
+static qsizetype findAvx2(
+    const char16_t* data,
+    const qsizetype size,
+    qsizetype pos,
+    const char16_t symbol)
+{
+    const auto pattern = _mm256_set1_epi16(static_cast<short>(symbol));
+    for (; pos + 16 <= size; pos += 16) {
+        const auto block = _mm256_loadu_si256(
+            reinterpret_cast<const __m256i*>(data + pos));
+        const auto mask = static_cast<quint32>(
+            _mm256_movemask_epi8(_mm256_cmpeq_epi16(block, pattern)));
+        if (mask != 0) { return pos + qCountTrailingZeroBits(mask) / 2; }
+    }
+
+    return findSse2(data, size, pos, symbol);
+}
+#endif
+
+// Function that finds position of the symbol in the data
+template <typename Char>
+using FindFunction = qsizetype (*)(const Char*, qsizetype, qsizetype, Char);
+
+// Select the fastest search function that is supported by the processor
+template <typename Char>
+static FindFunction<Char> selectFindFunction()
+{
+#if defined(QTCSV_SCANNER_AVX2)
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) { return &findAvx2; }
+
+    return &findSse2;
+#elif defined(QTCSV_SCANNER_SSE2)
+    return &findSse2;
+#else
+    return &findScalar<Char>;
+#endif
+}
+
+// Find position of the byte in the data
+// @input:
+// - data - pointer to the data
+// - size - size of the data
+// - pos - start position of the search
+// - symbol - symbol to find
+// @output:
+// - qsizetype - position of the symbol or size of the data if the symbol
+// was not found
+qsizetype QtCSV::FindSymbol(
+    const char* data,
+    const qsizetype size,
+    const qsizetype pos,
+    const char symbol)
+{
+    static const auto find = selectFindFunction<char>();
+    return find(data, size, pos, symbol);
+}
+
+// Find position of the symbol in the data
+// @input:
+// - data - pointer to the data
+// - size - size of the data
+// - pos - start position of the search
+// - symbol - symbol to find
+// @output:
+// - qsizetype - position of the symbol or size of the data if the symbol
+// was not found
+qsizetype QtCSV::FindSymbol(
+    const QChar* data,
+    const qsizetype size,
+    const qsizetype pos,
+    const QChar symbol)
+{
+    static const auto find = selectFindFunction<char16_t>();
+    return find(reinterpret_cast<const char16_t*>(data), size, pos,
+                symbol.unicode());
+}
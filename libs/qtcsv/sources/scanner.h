@@ -0,0 +1,26 @@
+#ifndef QTCSVSCANNER_H
+#define QTCSVSCANNER_H
+
+#include <QChar>
+#include <QtGlobal>
+
+namespace QtCSV {
+    // Find position of the symbol in the data. Data is scanned by blocks of
+    // 16 or 32 symbols with SSE2 or AVX2 instructions (AVX2 is used if it is
+    // supported by the processor), other processors use the scalar search.
+    // @input:
+    // - data - pointer to the data
+    // - size - size of the data
+    // - pos - start position of the search
+    // - symbol - symbol to find
+    // @output:
+    // - qsizetype - position of the symbol or size of the data if the symbol
+    // was not found
+    qsizetype FindSymbol(
+        const char* data, qsizetype size, qsizetype pos, char symbol);
+
+    qsizetype FindSymbol(
+        const QChar* data, qsizetype size, qsizetype pos, QChar symbol);
+}
+
+#endif // QTCSVSCANNER_H
@@ -0,0 +1,385 @@
+#ifndef QTCSVTOKENIZER_H
+#define QTCSVTOKENIZER_H
+
+#include "sources/scanner.h"
+#include <QChar>
+#include <QList>
+#include <QtGlobal>
+
+namespace QtCSV {
+
+    // Check if symbol is a space symbol that should be trimmed from elements
+    inline bool IsSpaceSymbol(const QChar symbol)
+    {
+        return symbol.unicode() == ' ' ||
+            (symbol.unicode() > 0x7F &&
+             symbol.category() == QChar::Separator_Space);
+    }
+
+    inline bool IsSpaceSymbol(const char symbol) { return symbol == ' '; }
+
+    // Tokenizer is a state machine that splits lines of csv-data into row
+    // elements. Each line is walked only once: quoting, double text delimiters
+    // (escaped text delimiters) and trimming of spaces are handled in the same
+    // pass, so the cost of splitting a line is linear in its length, regardless
+    // of the number of elements.
+    //
+    // Rules:
+    // - spaces around elements are removed;
+    // - element that starts with text delimiter (after spaces) is a quoted
+    // element. It ends with an odd number of text delimiters followed by
+    // a separator or by the end of the line (spaces between them are allowed).
+    // Inside of the quoted element double text delimiters are replaced with one
+    // text delimiter, other text delimiters are kept as is. Spaces inside of the
+    // text delimiters are kept;
+    // - quoted element that does not end on its line continues on the next line,
+    // lines are joined with LF symbol;
+    // - separator at the end of the line is followed by an empty element;
+    // - empty line is a row without elements;
+    // - if text delimiter is empty, elements are never quoted.
+    //
+    // Elements are returned as views. Elements that are located on one line and
+    // do not contain double text delimiters point into the line itself, other
+    // elements are assembled in the internal buffer of the tokenizer. Views are
+    // valid until the next call of tokenizeLine(), finishRow() or clearRow().
+    //
+    // Template parameters:
+    // - Char - type of symbols (QChar or char);
+    // - View - type of views into the data (QStringView or QByteArrayView);
+    // - Buffer - type of the internal buffer (QString or QByteArray).
+    template <typename Char, typename View, typename Buffer>
+    class Tokenizer {
+        // Element of the current row: position and size of the element in the
+        // current line or in the buffer
+        struct Element {
+            qsizetype pos;
+            qsizetype size;
+            bool inBuffer;
+        };
+
+        // Number of symbols that are searched without vectorized search
+        static constexpr qsizetype SCALAR_SEARCH_SIZE = 16;
+
+        const Buffer m_separator;
+        const Buffer m_textDelimiter;
+        QList<Element> m_elements;
+        QList<View> m_views;
+        Buffer m_buffer;
+        const Char* m_line = nullptr;
+        bool m_inQuotedElement = false;
+
+        // Check if data at position pos of the line starts with token
+        static bool startsWith(
+            const Char* line,
+            const qsizetype size,
+            const qsizetype pos,
+            const Buffer& token)
+        {
+            const auto tokenSize = token.size();
+            if (size - pos < tokenSize) { return false; }
+
+            const auto* tokenData = token.constData();
+            if (line[pos] != tokenData[0]) { return false; }
+
+            for (qsizetype i = 1; i < tokenSize; ++i) {
+                if (line[pos + i] != tokenData[i]) { return false; }
+            }
+
+            return true;
+        }
+
+        // Find position of the token in the line, starting from position pos.
+        // Returns size of the line if token was not found.
+        static qsizetype find(
+            const Char* line,
+            const qsizetype size,
+            qsizetype pos,
+            const Buffer& token)
+        {
+            // Short elements are checked in place, candidates in the rest of
+            // the line are found by the first symbol of the token with
+            // vectorized search
+            const auto first = token.constData()[0];
+            const auto scalarEnd = qMin(size, pos + SCALAR_SEARCH_SIZE);
+            for (; pos < scalarEnd; ++pos) {
+                if (line[pos] == first && startsWith(line, size, pos, token)) {
+                    return pos;
+                }
+            }
+
+            while (true) {
+                pos = FindSymbol(line, size, pos, first);
+                if (pos >= size || startsWith(line, size, pos, token)) {
+                    return pos;
+                }
+
+                ++pos;
+            }
+        }
+
+        // Skip spaces starting from position pos
+        static qsizetype skipSpaces(
+            const Char* line, const qsizetype size, qsizetype pos)
+        {
+            while (pos < size && IsSpaceSymbol(line[pos])) { ++pos; }
+            return pos;
+        }
+
+        // Add element that is located in the current line
+        void addLineElement(qsizetype begin, qsizetype end)
+        {
+            // Trim spaces
+            while (begin < end && IsSpaceSymbol(m_line[begin])) { ++begin; }
+            while (end > begin && IsSpaceSymbol(m_line[end - 1])) { --end; }
+            m_elements.append(Element{begin, end - begin, false});
+        }
+
+        // Append symbols to the last element, moving it to the buffer if it
+        // points into the current line
+        void appendToElement(const Char* data, const qsizetype size)
+        {
+            auto& element = m_elements.last();
+            if (!element.inBuffer) {
+                const auto pos = m_buffer.size();
+                m_buffer.append(m_line + element.pos, element.size);
+                element.pos = pos;
+                element.inBuffer = true;
+            }
+
+            m_buffer.append(data, size);
+            element.size += size;
+        }
+
+        // Move all elements of the row to the buffer in their order, so that
+        // they stay valid when the row continues on the next line and the last
+        // (unfinished) element could grow at the end of the buffer
+        void moveElementsToBuffer()
+        {
+            Buffer buffer;
+            for (auto& element : m_elements) {
+                const auto* data = element.inBuffer ?
+                    m_buffer.constData() + element.pos : m_line + element.pos;
+                const auto pos = buffer.size();
+                buffer.append(data, element.size);
+                element.pos = pos;
+                element.inBuffer = true;
+            }
+
+            m_buffer.swap(buffer);
+        }
+
+        // Parse quoted element from position pos of the current line. Position
+        // must point after the opening text delimiter or to the beginning of
+        // the continuation line.
+        // @input:
+        // - size - size of the current line
+        // - pos - start position
+        // - next - position of the next element if the element ends before the
+        // separator, or -1 if the element ends at the end of the line
+        // @output:
+        // - bool - True if the element ends on the current line, otherwise
+        // False
+        bool parseQuotedElement(
+            const qsizetype size, qsizetype pos, qsizetype& next)
+        {
+            const auto delimSize = m_textDelimiter.size();
+            const auto* delim = m_textDelimiter.constData();
+            auto chunkStart = pos;
+            while (true) {
+                const auto delimPos = find(m_line, size, pos, m_textDelimiter);
+                if (delimPos >= size) {
+                    // Element does not end on this line
+                    appendToElement(m_line + chunkStart, size - chunkStart);
+                    return false;
+                }
+
+                // Count text delimiters that stand together
+                qsizetype count = 1;
+                auto runEnd = delimPos + delimSize;
+                while (startsWith(m_line, size, runEnd, m_textDelimiter)) {
+                    ++count;
+                    runEnd += delimSize;
+                }
+
+                // If we have odd number of text delimiters followed by the
+                // separator or by the end of the line, then this is the even
+                // number of double text delimiters + closing text delimiter
+                const auto afterRun = skipSpaces(m_line, size, runEnd);
+                const auto isLineEnd = afterRun >= size;
+                if (count % 2 == 1 && (isLineEnd ||
+                        startsWith(m_line, size, afterRun, m_separator)))
+                {
+                    auto& element = m_elements.last();
+                    if (!element.inBuffer && count == 1) {
+                        // Element has no double text delimiters, so it could
+                        // stay in the line
+                        element.size = delimPos - chunkStart;
+                    }
+                    else {
+                        appendToElement(
+                            m_line + chunkStart, delimPos - chunkStart);
+                        for (qsizetype i = 0; i < count / 2; ++i) {
+                            appendToElement(delim, delimSize);
+                        }
+                    }
+
+                    next = isLineEnd ? -1 : afterRun + m_separator.size();
+                    return true;
+                }
+
+                // Otherwise double text delimiters are replaced with one text
+                // delimiter and single text delimiter is kept as is
+                appendToElement(m_line + chunkStart, delimPos - chunkStart);
+                for (qsizetype i = 0; i < count / 2 + count % 2; ++i) {
+                    appendToElement(delim, delimSize);
+                }
+
+                pos = runEnd;
+                chunkStart = runEnd;
+            }
+        }
+
+        // Split the current line to elements, starting from position pos that
+        // points to the beginning of an element
+        // @input:
+        // - size - size of the current line
+        // - pos - start position
+        // @output:
+        // - bool - True if the row ends on this line, otherwise False
+        bool parseElements(const qsizetype size, qsizetype pos)
+        {
+            const auto quoting = !m_textDelimiter.isEmpty();
+            while (true) {
+                const auto start = skipSpaces(m_line, size, pos);
+                if (quoting &&
+                    startsWith(m_line, size, start, m_textDelimiter))
+                {
+                    // Element starts with text delimiter. It could contain
+                    // separators, double text delimiters and line breaks.
+                    const auto contentStart = start + m_textDelimiter.size();
+                    m_elements.append(Element{contentStart, 0, false});
+
+                    qsizetype next = -1;
+                    if (!parseQuotedElement(size, contentStart, next)) {
+                        return continueRow();
+                    }
+
+                    if (next < 0) { break; }
+
+                    pos = next;
+                    continue;
+                }
+
+                // Element without text delimiters ends at the next separator
+                // or at the end of the line
+                const auto separatorPos = find(m_line, size, start, m_separator);
+                addLineElement(start, separatorPos);
+                if (separatorPos >= size) { break; }
+
+                // If line ends with separator, then the next iteration adds
+                // empty element
+                pos = separatorPos + m_separator.size();
+            }
+
+            buildViews();
+            return true;
+        }
+
+        // Mark that the current row continues on the next line
+        bool continueRow()
+        {
+            moveElementsToBuffer();
+            m_inQuotedElement = true;
+            return false;
+        }
+
+        // Build views of the row elements
+        void buildViews()
+        {
+            m_views.clear();
+            m_views.reserve(m_elements.size());
+            for (const auto& element : m_elements) {
+                const auto* data = element.inBuffer ?
+                    m_buffer.constData() + element.pos : m_line + element.pos;
+                m_views.append(View(data, element.size));
+            }
+        }
+
+    public:
+        Tokenizer(const Buffer& separator, const Buffer& textDelimiter) :
+            m_separator(separator), m_textDelimiter(textDelimiter) {}
+
+        // Check if there is an unfinished row: the last tokenized line ended
+        // inside of the quoted element
+        bool hasUnfinishedRow() const { return m_inQuotedElement; }
+
+        // Elements of the last finished row
+        const QList<View>& elements() const { return m_views; }
+
+        // Tokenize one line of data (without line break symbols). Line must
+        // stay valid until the row elements are processed.
+        // @input:
+        // - line - pointer to the line data
+        // - size - size of the line
+        // @output:
+        // - bool - True if the row ends on this line and its elements are
+        // available through elements(), False if the row continues on the
+        // next line
+        bool tokenizeLine(const Char* line, const qsizetype size)
+        {
+            if (!m_inQuotedElement) {
+                // Previous row ended, start a new one
+                clearRow();
+                m_line = line;
+                if (size == 0) {
+                    // Empty line is a row without elements
+                    return true;
+                }
+
+                return parseElements(size, 0);
+            }
+
+            // This line is a continuation of the quoted element of the
+            // previous line
+            m_line = line;
+            const Char lineFeed(u'\n');
+            appendToElement(&lineFeed, 1);
+
+            qsizetype next = -1;
+            if (!parseQuotedElement(size, 0, next)) { return false; }
+
+            m_inQuotedElement = false;
+            if (next < 0) {
+                buildViews();
+                return true;
+            }
+
+            return parseElements(size, next);
+        }
+
+        // Finish the unfinished row at the end of data
+        // @output:
+        // - bool - True if there was an unfinished row, then its elements are
+        // available through elements(), otherwise False
+        bool finishRow()
+        {
+            if (!m_inQuotedElement) { return false; }
+
+            m_inQuotedElement = false;
+            buildViews();
+            return true;
+        }
+
+        // Remove elements of the current row
+        void clearRow()
+        {
+            m_elements.clear();
+            m_views.clear();
+            m_buffer.resize(0);
+            m_line = nullptr;
+            m_inQuotedElement = false;
+        }
+    };
+}
+
+#endif // QTCSVTOKENIZER_H
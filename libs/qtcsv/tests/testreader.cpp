@@ -2,9 +2,12 @@
 #include "qtcsv/reader.h"
 #include "qtcsv/stringdata.h"
 #include "qtcsv/variantdata.h"
+#include <QBuffer>
 #include <QDir>
 #include <QFile>
 #include <QElapsedTimer>
+#include <QStringEncoder>
+#include <QTemporaryDir>
 
 void TestReader::testReadToListInvalidArgs() {
     QVERIFY2(QtCSV::Reader::readToList(QString(), QString()).empty(),
@@ -426,6 +429,298 @@ void TestReader::testReadByProcessorWithBreak() {
     }
 }
 
+void TestReader::testReadEmptyFieldAfterQuotedField() {
+    QByteArray content("\"one\",\"two\",\n\"three\" , ,\n");
+    QBuffer buffer(&content);
+    const auto data = QtCSV::Reader::readToList(buffer, ",", "\"");
+
+    QList<QList<QString>> expected;
+    expected << (QList<QString>() << "one" << "two" << QString());
+    expected << (QList<QString>() << "three" << QString() << QString());
+
+    QVERIFY2(expected == data, "Wrong row data");
+}
+
+void TestReader::testReadWithoutTextDelimiter() {
+    QByteArray content("\"one, two\",three\n");
+    QBuffer buffer(&content);
+    const auto data = QtCSV::Reader::readToList(buffer, ",", QString());
+
+    QList<QList<QString>> expected;
+    expected << (QList<QString>() << "\"one" << "two\"" << "three");
+
+    QVERIFY2(expected == data, "Wrong row data");
+}
+
+void TestReader::testReadWideRow() {
+    const auto columns = 10000;
+    QList<QString> expectedRow;
+    QByteArray content;
+    for (auto i = 0; i < columns; ++i) {
+        const auto value = QString::number(i);
+        if (i % 2 == 0) {
+            expectedRow << value;
+            content.append(value.toUtf8());
+        }
+        else {
+            expectedRow << value + ", \"" + value + "\"";
+            content.append("\"" + value.toUtf8() + ", \"\"" + value.toUtf8() +
+                           "\"\"\"");
+        }
+
+        content.append(i + 1 < columns ? "," : "\n");
+    }
+
+    QBuffer buffer(&content);
+    QElapsedTimer timer;
+    timer.start();
+    const auto data = QtCSV::Reader::readToList(buffer, ",", "\"");
+    qDebug() << "Elapsed time:" << timer.elapsed() << "ms";
+
+    QVERIFY2(data.size() == 1, "Wrong number of rows");
+    QVERIFY2(data.first() == expectedRow, "Wrong row data");
+}
+
+void TestReader::testReadByViewProcessor() {
+    class ViewProcessor : public QtCSV::Reader::AbstractViewProcessor {
+    public:
+        QList<QList<QString>> data;
+        size_t rawLines = 0;
+
+        void preProcessRawLine(QString& /*editable_line*/) override {
+            ++rawLines;
+        }
+
+        bool processRowViews(const QList<QStringView>& elements) override {
+            QList<QString> row;
+            for (const auto& element : elements) {
+                row << element.toString();
+            }
+
+            data << row;
+            return true;
+        }
+    };
+
+    const auto path = getPathToFileTestDataCorrectness();
+    ViewProcessor processor;
+    QVERIFY2(QtCSV::Reader::readToProcessor(path, processor, ",", "\""),
+             "Failed to read file content");
+
+    QVERIFY2(processor.rawLines == 0, "Raw lines were preprocessed");
+    QVERIFY2(QtCSV::Reader::readToList(path, ",", "\"") == processor.data,
+             "Wrong row data");
+}
+
+void TestReader::testReadByViewProcessorWithPreProcessing() {
+    class SumProcessor : public QtCSV::Reader::AbstractViewProcessor {
+    public:
+        qint64 sum = 0;
+        size_t rows = 0;
+
+        bool preProcessesRawLines() const override { return true; }
+
+        void preProcessRawLine(QString& editable_line) override {
+            editable_line.replace(';', ',');
+        }
+
+        bool processRowViews(const QList<QStringView>& elements) override {
+            for (const auto& element : elements) {
+                auto ok = false;
+                sum += element.toLongLong(&ok);
+                if (!ok) { return false; }
+            }
+
+            ++rows;
+            return true;
+        }
+    };
+
+    QByteArray content("1;2,3\n 4 ,\"5\"\n6\nseven\n8\n");
+    QBuffer buffer(&content);
+    SumProcessor processor;
+    QVERIFY2(!QtCSV::Reader::readToProcessor(buffer, processor, ",", "\""),
+             "Reading was not stopped by processor");
+
+    QVERIFY2(processor.rows == 3, "Wrong number of rows");
+    QVERIFY2(processor.sum == 21, "Wrong row data");
+}
+
+// Utf8Processor - processor that decodes UTF-8 encoded row elements
+class Utf8Processor : public QtCSV::Reader::AbstractUtf8Processor {
+public:
+    QList<QList<QString>> data;
+
+    bool processRowUtf8(const QList<QByteArrayView>& elements) override {
+        QList<QString> row;
+        for (const auto& element : elements) {
+            row << QString::fromUtf8(element);
+        }
+
+        data << row;
+        return true;
+    }
+};
+
+void TestReader::testReadByUtf8Processor() {
+    const QList<QString> paths = {
+        getPathToFileTestDataCorrectness(),
+        getPathToFileTestFieldWithCR(),
+        getPathToFileTestFieldWithCRLFLong(),
+        getPathToFileTestFieldEndTripleQuotes(),
+        getPathToFileMultirowData(),
+    };
+
+    for (const auto& path : paths) {
+        Utf8Processor processor;
+        QVERIFY2(QtCSV::Reader::readToProcessor(path, processor, ",", "\""),
+                 "Failed to read file content");
+        QVERIFY2(QtCSV::Reader::readToList(path, ",", "\"") == processor.data,
+                 "Wrong row data");
+    }
+}
+
+void TestReader::testReadByUtf8ProcessorWithBom() {
+    QByteArray content("\xEF\xBB\xBFid,name\r\n"
+                       "1, \"G\xC3\xB6k\xC3\xA7\x65, K.\" \r\n"
+                       "2,\xE2\x82\xAC");
+    QBuffer buffer(&content);
+    Utf8Processor processor;
+    QVERIFY2(QtCSV::Reader::readToProcessor(buffer, processor),
+             "Failed to read data");
+
+    QList<QList<QString>> expected;
+    expected << (QList<QString>() << "id" << "name");
+    expected << (QList<QString>() << "1" <<
+                 QString::fromUtf8("G\xC3\xB6k\xC3\xA7\x65, K."));
+    expected << (QList<QString>() << "2" << QString::fromUtf8("\xE2\x82\xAC"));
+
+    QVERIFY2(expected == processor.data, "Wrong row data");
+}
+
+void TestReader::testReadByUtf8ProcessorLongRows() {
+    // Rows are longer than the chunk of data that reader reads at once
+    const QByteArray longValue(200 * 1024, 'x');
+    QByteArray content;
+    content.append("first," + longValue + "\n");
+    content.append("\"" + longValue + "\n" + longValue + "\",last\n");
+    content.append("end");
+
+    QBuffer buffer(&content);
+    Utf8Processor processor;
+    QVERIFY2(QtCSV::Reader::readToProcessor(buffer, processor),
+             "Failed to read data");
+
+    const auto value = QString::fromUtf8(longValue);
+    QList<QList<QString>> expected;
+    expected << (QList<QString>() << "first" << value);
+    expected << (QList<QString>() << value + "\n" + value << "last");
+    expected << (QList<QString>() << "end");
+
+    QVERIFY2(expected == processor.data, "Wrong row data");
+}
+
+void TestReader::testReadFieldsOfDifferentLength() {
+    // Fields are shorter and longer than the blocks of vectorized search,
+    // separators and text delimiters are located at all positions of blocks
+    QList<QList<QString>> expected;
+    QByteArray content;
+    for (auto length = 0; length < 80; ++length) {
+        const QString value(length, QChar('a' + length % 26));
+        const auto quotedValue = value.left(length / 2) + "\"," +
+            value.mid(length / 2);
+
+        expected << (QList<QString>() << value << quotedValue << value);
+        content.append(value.toUtf8() + ",\"" +
+                       QString(quotedValue).replace("\"", "\"\"").toUtf8() +
+                       "\"," + value.toUtf8() + "\n");
+    }
+
+    QBuffer buffer(&content);
+    const auto data = QtCSV::Reader::readToList(buffer, ",", "\"");
+    QVERIFY2(expected == data, "Wrong row data");
+
+    buffer.close();
+    Utf8Processor processor;
+    QVERIFY2(QtCSV::Reader::readToProcessor(buffer, processor, ",", "\""),
+             "Failed to read data");
+    QVERIFY2(expected == processor.data, "Wrong row data");
+}
+
+void TestReader::testReadMappedFiles() {
+    // Files that are read by path are mapped into memory, results should be
+    // the same as results of reading them as IO Devices
+    const QList<QPair<QString, QString>> files = {
+        {getPathToFileTestComma(), ","},
+        {getPathToFileTestSemicolon(), ";"},
+        {getPathToFileTestDataTextDelimDQuotes(), ","},
+        {getPathToFileTestFieldWithCR(), ";"},
+        {getPathToFileTestFieldWithCRLF(), ","},
+        {getPathToFileTestFieldWithCRLFLong(), ","},
+        {getPathToFileTestDataCorrectness(), ","},
+        {getPathToFileWithEmptyFieldsComplexSeparator(), ";-;"},
+        {getPathToFileMultirowData(), ","},
+    };
+
+    for (const auto& file : files) {
+        const auto data = QtCSV::Reader::readToList(file.first, file.second);
+        QVERIFY2(!data.isEmpty(), "Failed to read file content");
+
+        QFile device(file.first);
+        QVERIFY2(data == QtCSV::Reader::readToList(device, file.second),
+                 "Wrong row data");
+
+        Utf8Processor processor;
+        QVERIFY2(QtCSV::Reader::readToProcessor(
+                     file.first, processor, file.second),
+                 "Failed to read file content");
+        QVERIFY2(data == processor.data, "Wrong row data");
+    }
+}
+
+void TestReader::testReadMappedFileWithUtf16Bom() {
+    QTemporaryDir dir;
+    QVERIFY2(dir.isValid(), "Failed to create temporary directory");
+
+    const auto path = dir.filePath("test-utf16.csv");
+    QFile file(path);
+    QVERIFY2(file.open(QIODevice::WriteOnly), "Failed to create file");
+
+    QStringEncoder encoder(
+        QStringConverter::Utf16LE, QStringConverter::Flag::WriteBom);
+    const QByteArray content =
+        encoder(QString("one,two\r\n\"three\nfour\",five"));
+    file.write(content);
+    file.close();
+
+    // Encoding is detected by byte order mark
+    const auto data = QtCSV::Reader::readToList(path);
+
+    QList<QList<QString>> expected;
+    expected << (QList<QString>() << "one" << "two");
+    expected << (QList<QString>() << "three\nfour" << "five");
+
+    QVERIFY2(expected == data, "Wrong row data");
+}
+
+void TestReader::testReadEmptyFile() {
+    QTemporaryDir dir;
+    QVERIFY2(dir.isValid(), "Failed to create temporary directory");
+
+    // Empty file could not be mapped into memory, it is read as IO Device
+    const auto path = dir.filePath("test-empty.csv");
+    QFile file(path);
+    QVERIFY2(file.open(QIODevice::WriteOnly), "Failed to create file");
+    file.close();
+
+    QVERIFY2(QtCSV::Reader::readToList(path).isEmpty(), "Wrong row data");
+
+    Utf8Processor processor;
+    QVERIFY2(QtCSV::Reader::readToProcessor(path, processor),
+             "Failed to read file content");
+    QVERIFY2(processor.data.isEmpty(), "Wrong row data");
+}
+
 QString TestReader::getPathToFolderWithTestFiles() const {
     return QDir::currentPath() + "/data/";
 }
@@ -34,6 +34,18 @@ private Q_SLOTS:
     void testReadFileWithEmptyFieldsComplexSeparator();
     void testReadFileWithMultirowData();
     void testReadByProcessorWithBreak();
+    void testReadEmptyFieldAfterQuotedField();
+    void testReadWithoutTextDelimiter();
+    void testReadWideRow();
+    void testReadByViewProcessor();
+    void testReadByViewProcessorWithPreProcessing();
+    void testReadByUtf8Processor();
+    void testReadByUtf8ProcessorWithBom();
+    void testReadByUtf8ProcessorLongRows();
+    void testReadFieldsOfDifferentLength();
+    void testReadMappedFiles();
+    void testReadMappedFileWithUtf16Bom();
+    void testReadEmptyFile();
 
 private:
     QString getPathToFolderWithTestFiles() const;
@@ -0,0 +1,291 @@
+/*
+ * Copyright (c) 2022 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "CommandQueue.h"
+
+#include <QSettings>
+
+#include <Misc/Console.h>
+#include <Misc/SteadyClock.h>
+#include <XBee/FrameDecoder.h>
+#include <SerialStudio/Plugin.h>
+
+/*
+ * Maximum number of SIMP commands waiting to be sent, older ones are discarded
+ */
+static constexpr int MAX_SIMULATION_BACKLOG = 4;
+
+/*
+ * Size of a transmit request frame without its payload
+ */
+static constexpr int FRAME_OVERHEAD = 18;
+
+/*
+ * Console prefix of transmitted commands
+ */
+static const QString TX_PREFIX = QStringLiteral(" [Control Panel]   [TX] ");
+
+/**
+ * Constructor function
+ */
+CanSat::CommandQueue::CommandQueue(QObject *parent)
+    : QObject(parent)
+    , m_trackDelivery(false)
+    , m_maxRetries(2)
+    , m_statusTimeout(1000)
+    , m_lastFrameId(0)
+    , m_budget(0)
+    , m_budgetRate(1000)
+    , m_lastRefill(0)
+{
+    m_clock.start();
+    loadSettings();
+}
+
+/**
+ * Returns the number of commands waiting to be sent
+ */
+int CanSat::CommandQueue::pendingCommands() const
+{
+    return m_queues[Control].count() + m_queues[Simulation].count();
+}
+
+/**
+ * Returns the number of commands waiting for their transmit status
+ */
+int CanSat::CommandQueue::commandsInFlight() const
+{
+    return m_inFlight.count();
+}
+
+/**
+ * Discards all pending commands & stops waiting for transmit status frames
+ */
+void CanSat::CommandQueue::clear()
+{
+    m_queues[Control].clear();
+    m_queues[Simulation].clear();
+    m_inFlight.clear();
+}
+
+/**
+ * Reads the XBee destination, air-time budget (bytes per second), retry count &
+ * transmit status timeout (milliseconds) from the application settings
+ */
+void CanSat::CommandQueue::loadSettings()
+{
+    m_builder.loadSettings();
+
+    QSettings settings;
+    const auto mode = settings.value("XBee/ApiMode", 0).toInt();
+    m_trackDelivery = mode != static_cast<int>(XBee::ApiMode::Transparent);
+    m_budgetRate = qMax(1, settings.value("XBee/AirTimeBudget", 1000).toInt());
+    m_maxRetries = qMax(0, settings.value("XBee/MaxRetries", 2).toInt());
+    m_statusTimeout = qMax(1, settings.value("XBee/StatusTimeout", 1000).toInt());
+    m_budget = m_budgetRate;
+    m_lastRefill = m_clock.elapsed();
+}
+
+/**
+ * Adds the given @a command to the queue of its @a priority class & sends as many
+ * queued commands as the air-time budget allows
+ */
+bool CanSat::CommandQueue::enqueue(const QString &command,
+                                   const CanSat::CommandQueue::Priority priority)
+{
+    // Validate command
+    if (command.isEmpty())
+        return false;
+
+    // Only keep the most recent simulated pressure readings
+    auto &queue = m_queues[priority];
+    if (priority == Simulation && queue.count() >= MAX_SIMULATION_BACKLOG)
+    {
+        queue.removeFirst();
+        Misc::Console::instance().append(
+            " [Control Panel] [WARN] Air-time budget exceeded, SIMP command dropped");
+    }
+
+    // Command type is the third field (e.g. CMD,1099,CX,ON;)
+    const auto type = command.section(',', 2, 2).remove(';');
+    queue.append({ command, type, priority, 0, 0, 0 });
+
+    // Try to send the command right away
+    processQueue();
+    return true;
+}
+
+/**
+ * Retries timed out commands & sends queued commands, control commands first, while
+ * the air-time budget allows it
+ */
+void CanSat::CommandQueue::processQueue()
+{
+    refillBudget();
+    checkTimeouts();
+
+    for (auto &queue : m_queues)
+    {
+        while (!queue.isEmpty())
+        {
+            // Frames larger than the bucket are sent when the bucket is full
+            const auto size = FRAME_OVERHEAD + queue.first().text.size();
+            const auto cost = qMin<double>(m_budgetRate, size);
+            if (m_budget < cost)
+                return;
+
+            auto command = queue.takeFirst();
+            if (transmit(command))
+                m_budget -= cost;
+        }
+    }
+}
+
+/**
+ * Matches a transmit status frame with the command that was sent with the same
+ * @a frameId. Delivered commands are reported, failed ones are retried.
+ */
+void CanSat::CommandQueue::onTransmitStatus(const quint8 frameId, const quint8 retries,
+                                            const quint8 deliveryStatus)
+{
+    Q_UNUSED(retries);
+
+    // Frame ID does not belong to a command that we are waiting for
+    auto it = m_inFlight.find(frameId);
+    if (it == m_inFlight.end())
+        return;
+
+    // Remove command from the in-flight list
+    auto command = it.value();
+    m_inFlight.erase(it);
+
+    // Command delivered
+    if (deliveryStatus == 0x00)
+    {
+        const auto latency = m_clock.elapsed() - command.firstSent;
+        Q_EMIT commandDelivered(command.type, latency, command.attempts - 1);
+    }
+
+    // Delivery failed, send command again
+    else
+        retry(command, tr("delivery status 0x%1").arg(deliveryStatus, 2, 16, QChar('0')));
+
+    // Send pending commands
+    processQueue();
+}
+
+/**
+ * Returns the next frame ID (1-255) that is not used by a command in flight
+ */
+quint8 CanSat::CommandQueue::nextFrameId()
+{
+    for (int i = 0; i < 255; ++i)
+    {
+        m_lastFrameId = static_cast<quint8>(m_lastFrameId % 255 + 1);
+        if (!m_inFlight.contains(m_lastFrameId))
+            break;
+    }
+
+    return m_lastFrameId;
+}
+
+/**
+ * Adds the bytes that can be sent since the last refill to the air-time budget, the
+ * budget never exceeds one second of transmissions
+ */
+void CanSat::CommandQueue::refillBudget()
+{
+    const auto now = m_clock.elapsed();
+    m_budget += (now - m_lastRefill) * m_budgetRate / 1000.0;
+    m_budget = qMin(m_budget, m_budgetRate);
+    m_lastRefill = now;
+}
+
+/**
+ * Retries the commands that did not receive a transmit status in time
+ */
+void CanSat::CommandQueue::checkTimeouts()
+{
+    const auto now = m_clock.elapsed();
+    for (auto it = m_inFlight.begin(); it != m_inFlight.end();)
+    {
+        if (now - it.value().lastSent >= m_statusTimeout)
+        {
+            auto command = it.value();
+            it = m_inFlight.erase(it);
+            retry(command, tr("no transmit status received"));
+        }
+
+        else
+            ++it;
+    }
+}
+
+/**
+ * Builds the API frame of the given @a command & sends it to Serial Studio. If
+ * delivery tracking is enabled, the command waits for its transmit status.
+ */
+bool CanSat::CommandQueue::transmit(Command &command)
+{
+    // Build frame
+    const auto frameId = nextFrameId();
+    const auto &frame = m_builder.build(frameId, command.text);
+
+    // Send frame
+    if (!SerialStudio::Plugin::instance().write(frame))
+    {
+        Q_EMIT commandFailed(command.text, tr("not connected to Serial Studio"));
+        return false;
+    }
+
+    // Update command timing
+    const auto now = m_clock.elapsed();
+    if (command.attempts == 0)
+        command.firstSent = now;
+
+    command.lastSent = now;
+    command.attempts += 1;
+
+    // Wait for transmit status
+    if (m_trackDelivery)
+        m_inFlight.insert(frameId, command);
+
+    // Notify first transmission
+    if (command.attempts == 1)
+        Q_EMIT commandSent(command.text, Misc::SteadyClock::microseconds());
+
+    // Show command in console
+    Misc::Console::instance().append(TX_PREFIX + command.text);
+    return true;
+}
+
+/**
+ * Queues the given @a command again at the front of its priority class, or reports
+ * it as failed if it has been sent too many times
+ */
+void CanSat::CommandQueue::retry(Command &command, const QString &reason)
+{
+    if (command.attempts > m_maxRetries)
+        Q_EMIT commandFailed(command.text, reason);
+    else
+        m_queues[command.priority].prepend(command);
+}
@@ -0,0 +1,118 @@
+/*
+ * Copyright (c) 2022 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#pragma once
+
+#include <QList>
+#include <QHash>
+#include <QObject>
+#include <QElapsedTimer>
+
+#include <XBee/FrameBuilder.h>
+
+namespace CanSat
+{
+/**
+ * @brief The CommandQueue class
+ *
+ * Schedules the commands sent to the CanSat through the XBee radio. Commands are kept
+ * in two priority classes: control commands (CX, ST, CAL, SIM...) are always sent
+ * before simulated pressure (SIMP) commands, and only the most recent SIMP commands
+ * are kept if the simulation produces them faster than they can be sent.
+ *
+ * Transmissions are paced with a token bucket that limits the number of bytes sent
+ * to the radio per second (@c XBee/AirTimeBudget setting), so that radio usage stays
+ * predictable during command bursts.
+ *
+ * Each transmitted frame gets a non-zero frame ID. When the XBee interface runs in
+ * API mode, the transmit status (0x8B) reported by the radio is matched with the
+ * command that was sent: failed or unacknowledged commands are retried up to
+ * @c XBee/MaxRetries times, and the delivery latency of successful commands is
+ * reported with the @c commandDelivered() signal.
+ *
+ * The first transmission of each command is reported with the @c commandSent()
+ * signal, along with its steady clock time stamp in microseconds.
+ */
+class CommandQueue : public QObject
+{
+    // clang-format off
+    Q_OBJECT
+    // clang-format on
+
+Q_SIGNALS:
+    void commandSent(const QString &command, const qint64 time);
+    void commandDelivered(const QString &type, const qint64 latency, const int retries);
+    void commandFailed(const QString &command, const QString &reason);
+
+public:
+    enum Priority
+    {
+        Control,
+        Simulation,
+    };
+
+    explicit CommandQueue(QObject *parent = nullptr);
+
+    int pendingCommands() const;
+    int commandsInFlight() const;
+
+public Q_SLOTS:
+    void clear();
+    void loadSettings();
+    void processQueue();
+    bool enqueue(const QString &command, const CanSat::CommandQueue::Priority priority);
+    void onTransmitStatus(const quint8 frameId, const quint8 retries,
+                          const quint8 deliveryStatus);
+
+private:
+    struct Command
+    {
+        QString text;
+        QString type;
+        Priority priority;
+        int attempts;
+        qint64 firstSent;
+        qint64 lastSent;
+    };
+
+    quint8 nextFrameId();
+    void refillBudget();
+    void checkTimeouts();
+    bool transmit(Command &command);
+    void retry(Command &command, const QString &reason);
+
+private:
+    bool m_trackDelivery;
+    int m_maxRetries;
+    int m_statusTimeout;
+    quint8 m_lastFrameId;
+
+    double m_budget;
+    double m_budgetRate;
+    qint64 m_lastRefill;
+    QElapsedTimer m_clock;
+
+    XBee::FrameBuilder m_builder;
+    QList<Command> m_queues[2];
+    QHash<quint8, Command> m_inFlight;
+};
+}
@@ -23,26 +23,51 @@
 #include "ControlPanel.h"
 
 #include <QDir>
-#include <QTimer>
+#include <QDateTime>
+#include <QSettings>
+#include <QElapsedTimer>
+#include <QCoreApplication>
 #include <QFileInfo>
 #include <QJsonArray>
 #include <QFileDialog>
 #include <QJsonObject>
 #include <QJsonDocument>
 
-#include <qtcsv/reader.h>
+#include <Misc/Console.h>
 #include <Misc/Utilities.h>
 #include <Misc/TimerEvents.h>
+#include <Misc/Notifications.h>
 #include <SerialStudio/Plugin.h>
+#include <CanSat/IngestionWorker.h>
+
+/*
+ * Maximum number of received frames displayed on each user interface update
+ */
+static constexpr int MAX_FRAMES_PER_UPDATE = 64;
+
+/*
+ * Console prefix of received frames
+ */
+static const QString RX_PREFIX = QStringLiteral(" [Control Panel]   [RX] ");
+
+/*
+ * Time to wait after activating the simulation before sending the first SIMP command
+ */
+static constexpr int SIMULATION_PRE_ROLL = 5000;
 
 /**
  * Constructor function
  */
 CanSat::ControlPanel::ControlPanel()
+    : m_commands(this)
+    , m_simulation(this)
 {
     // Set default values
     m_row = 0;
+    m_droppedFrames = 0;
+    m_latencyChanged = false;
     m_currentTime = "";
+    m_serialStudioConnected = false;
     m_simulationEnabled = false;
     m_simulationActivated = false;
     m_containerTelemetryEnabled = false;
@@ -51,11 +76,61 @@ CanSat::ControlPanel::ControlPanel()
     auto te = &(Misc::TimerEvents::instance());
     connect(te, &Misc::TimerEvents::timeout20Hz, this,
             &CanSat::ControlPanel::updateCurrentTime);
-
-    // Plugins comm signals/slots
-    auto pc = &(SerialStudio::Plugin::instance());
-    connect(pc, &SerialStudio::Plugin::dataReceived, this,
-            &CanSat::ControlPanel::onDataReceived);
+    connect(te, &Misc::TimerEvents::timeout20Hz, this,
+            &CanSat::ControlPanel::processFrames);
+    connect(te, &Misc::TimerEvents::timeout20Hz, &m_commands,
+            &CanSat::CommandQueue::processQueue);
+    connect(te, &Misc::TimerEvents::timeout1Hz, this,
+            &CanSat::ControlPanel::updateCommandLatency);
+
+    // Command queue signals/slots
+    connect(&m_commands, &CanSat::CommandQueue::commandFailed, this,
+            [=](const QString &command, const QString &reason) {
+                Q_EMIT printLn("[WARN] Command " + command + " failed: " + reason);
+            });
+    connect(&m_commands, &CanSat::CommandQueue::commandSent, this,
+            [=](const QString &command, const qint64 time) {
+                m_latency.commandSent(command, time);
+            });
+    connect(&m_commands, &CanSat::CommandQueue::commandDelivered, this,
+            [=](const QString &type, const qint64 latency, const int retries) {
+                // Delivery latency is reported in milliseconds
+                m_latency.commandDelivered(type, latency * 1000);
+                m_latencyChanged = true;
+                if (retries > 0)
+                    Q_EMIT printLn(QString("[INFO] Command %1 delivered after %2 "
+                                           "retries (%3 ms)")
+                                       .arg(type)
+                                       .arg(retries)
+                                       .arg(latency));
+            });
+
+    // Simulation scheduler signals/slots
+    connect(&m_simulation, &CanSat::SimulationScheduler::tick, this,
+            &CanSat::ControlPanel::sendSimulatedData);
+
+    // Write latency summary when the application quits
+    connect(QCoreApplication::instance(), &QCoreApplication::aboutToQuit, this,
+            &CanSat::ControlPanel::writeLatencySummary);
+
+    // Ingestion thread signals/slots
+    auto iw = &(CanSat::IngestionWorker::instance());
+    connect(iw, &CanSat::IngestionWorker::printLn, this,
+            &CanSat::ControlPanel::printLn);
+    connect(iw, &CanSat::IngestionWorker::errorOccurred, this,
+            &CanSat::ControlPanel::onIngestionError);
+    connect(iw, &CanSat::IngestionWorker::transmitStatusReceived, &m_commands,
+            &CanSat::CommandQueue::onTransmitStatus);
+
+    // Serial Studio plugin signals/slots. The plugin lives in the ingestion thread, so
+    // its connection state is mirrored here for the user interface.
+    auto plugin = &(SerialStudio::Plugin::instance());
+    connect(plugin, &SerialStudio::Plugin::connectedChanged, this,
+            &CanSat::ControlPanel::onPluginConnectedChanged, Qt::QueuedConnection);
+
+    // Restore last simulation profile once the console is connected
+    QMetaObject::invokeMethod(this, &CanSat::ControlPanel::restoreLastProfile,
+                              Qt::QueuedConnection);
 }
 
 /**
@@ -96,7 +171,34 @@ bool CanSat::ControlPanel::containerTelemetryEnabled() const
  */
 bool CanSat::ControlPanel::simulationCsvLoaded() const
 {
-    return m_file.isOpen();
+    return !m_profile.isEmpty();
+}
+
+/**
+ * Returns the round-trip latency statistics of each command type
+ */
+QVariantList CanSat::ControlPanel::commandLatency() const
+{
+    return m_latency.statistics();
+}
+
+/**
+ * Returns the delivery latency statistics (until the radio acknowledged the
+ * transmission) of each command type
+ */
+QVariantList CanSat::ControlPanel::deliveryLatency() const
+{
+    return m_latency.deliveryStatistics();
+}
+
+/**
+ * Returns @c true if the application is connected to Serial Studio. Unlike
+ * @c SerialStudio::Plugin::isConnected(), the value only changes in the GUI thread, so
+ * it can be safely used by QML bindings.
+ */
+bool CanSat::ControlPanel::serialStudioConnected() const
+{
+    return m_serialStudioConnected;
 }
 
 /**
@@ -114,7 +216,7 @@ QString CanSat::ControlPanel::csvFileName() const
 {
     if (simulationCsvLoaded())
     {
-        auto fileInfo = QFileInfo(m_file.fileName());
+        auto fileInfo = QFileInfo(m_profile.fileName());
         return fileInfo.fileName();
     }
 
@@ -123,7 +225,8 @@ QString CanSat::ControlPanel::csvFileName() const
 
 /**
  * Opens a dialog that allows the user to select a CSV file to load to the application.
- * The CSV file must contain only one column with simulated pressure data.
+ * The CSV file must contain one pressure reading per line, either as a single column
+ * or as the last field of a SIMP command.
  */
 void CanSat::ControlPanel::openCsv()
 {
@@ -137,66 +240,77 @@ void CanSat::ControlPanel::openCsv()
     if (name.isEmpty())
         return;
 
-    // Close current file
-    if (m_file.isOpen())
-        m_file.close();
-
-    // Open the selected file
-    m_file.setFileName(name);
-    if (m_file.open(QFile::ReadOnly))
-    {
-        // Close temp. file
-        if (m_tempFile.isOpen())
-            m_tempFile.close();
-
-        // Disable simulation mode
-        if (simulationActivated())
-            setSimulationActivated(false);
-
-        // Generate CSV data
-        QString csv;
-        QTextStream in(&m_file);
-        while (!in.atEnd())
-        {
-            QString line = in.readLine();
-            line.replace(" ", "");
-            if (line.startsWith("#") || line.isEmpty())
-                continue;
-            else
-            {
-                line.replace("$", "1099");
-                csv.append(line);
-                csv.append("\n");
-            }
-        }
-
-        // Save CSV file to temp path
-        m_tempFile.setFileName(QDir::tempPath() + "/CC2023_temp.csv");
-        if (m_tempFile.open(QFile::WriteOnly))
-        {
-            m_tempFile.write(csv.toUtf8());
-            m_tempFile.close();
-        }
+    // Load failure, alert user through a messagebox
+    if (!loadProfile(name))
+        Misc::Utilities::showMessageBox(tr("File open error"), m_profile.errorString());
+}
 
-        // Read CSV data
-        if (m_tempFile.open(QFile::ReadOnly))
-        {
-            m_row = 1;
-            m_csvData = QtCSV::Reader::readToList(m_tempFile);
-        }
+/**
+ * Loads the pressure readings of the simulation profile at the given @a fileName and
+ * remembers the profile so that it can be restored when the application starts again.
+ *
+ * Returns @c false if the profile could not be loaded.
+ */
+bool CanSat::ControlPanel::loadProfile(const QString &fileName)
+{
+    // Disable simulation mode
+    if (simulationActivated())
+        setSimulationActivated(false);
 
-        // Update UI
-        Q_EMIT printLn("[INFO] Loaded simulation CSV file from " + m_file.fileName());
-        Q_EMIT printLn("[INFO] Processed simulation CSV saved at "
-                       + m_tempFile.fileName());
+    // Load pressure readings
+    QElapsedTimer timer;
+    timer.start();
+    const auto loaded = m_profile.load(fileName);
+    if (loaded)
+    {
+        m_row = 0;
+        Q_EMIT printLn(QString("[INFO] Loaded %1 pressure readings from %2 in %3 ms%4")
+                           .arg(m_profile.count())
+                           .arg(m_profile.fileName())
+                           .arg(timer.elapsed())
+                           .arg(m_profile.loadedFromCache() ? " (cached)" : ""));
+
+        if (m_profile.skippedLines() > 0)
+            Q_EMIT printLn(QString("[WARN] %1 lines without pressure readings skipped")
+                               .arg(m_profile.skippedLines()));
+
+        QSettings().setValue("Simulation/LastProfile", m_profile.fileName());
     }
 
-    // Open failure, alert user through a messagebox
-    else
-        Misc::Utilities::showMessageBox(tr("File open error"), m_file.errorString());
-
     // Update UI
     emit csvFileNameChanged();
+    return loaded;
+}
+
+/**
+ * Loads the simulation profile that was used in the previous session, if it still
+ * exists. Profiles that were seen before are loaded directly from the profile cache.
+ */
+void CanSat::ControlPanel::restoreLastProfile()
+{
+    // Get last profile
+    const auto name = QSettings().value("Simulation/LastProfile").toString();
+    if (name.isEmpty() || !QFileInfo::exists(name))
+        return;
+
+    // Load profile, report failures through the console
+    if (!loadProfile(name))
+        Q_EMIT printLn(QString("[WARN] Cannot restore simulation profile %1: %2")
+                           .arg(name, m_profile.errorString()));
+}
+
+/**
+ * Mirrors the connection state of the Serial Studio plugin (which lives in the ingestion
+ * thread) and notifies the user interface from the GUI thread.
+ */
+void CanSat::ControlPanel::onPluginConnectedChanged()
+{
+    const auto connected = SerialStudio::Plugin::instance().isConnected();
+    if (m_serialStudioConnected != connected)
+    {
+        m_serialStudioConnected = connected;
+        Q_EMIT serialStudioConnectedChanged();
+    }
 }
 
 /**
@@ -234,6 +348,7 @@ void CanSat::ControlPanel::setSimulationMode(const bool enabled)
 {
     if (SerialStudio::Plugin::instance().isConnected())
     {
+        stopSimulationScheduler();
         m_simulationActivated = false;
         m_simulationEnabled = enabled;
         emit simulationEnabledChanged();
@@ -259,8 +374,9 @@ void CanSat::ControlPanel::setSimulationActivated(const bool activated)
             m_simulationActivated = true;
             emit simulationActivatedChanged();
             sendData("CMD,1099,SIM,ACTIVATE;");
-            Q_EMIT printLn("[INFO] Wating 5 seconds before sending data...");
-            QTimer::singleShot(5000, this, SLOT(sendSimulatedData()));
+            Q_EMIT printLn(QString("[INFO] Waiting %1 seconds before sending data...")
+                               .arg(SIMULATION_PRE_ROLL / 1000.0));
+            m_simulation.start(SIMULATION_PRE_ROLL);
         }
 
         else
@@ -287,43 +403,102 @@ void CanSat::ControlPanel::setContainerTelemetryEnabled(const bool enabled)
 }
 
 /**
- * Reads incoming data from Serial Studio
+ * Displays the frames received by the ingestion thread since the last user interface
+ * update. At most @c MAX_FRAMES_PER_UPDATE frames are taken from the ingestion queue,
+ * the rest are processed in the next updates. The telemetry history is filled by the
+ * ingestion thread, so it keeps the frames that are not displayed.
  */
-void CanSat::ControlPanel::onDataReceived(const QByteArray &data)
+void CanSat::ControlPanel::processFrames()
 {
-    // Append data to buffer
-    m_dataBuffer.append(data);
-
-    // Read until start/finish combinations are not found
-    auto bytes = 0;
-    auto cursor = m_dataBuffer;
-    auto start = QString("/*").toUtf8();
-    auto finish = QString("*/").toUtf8();
-    while (cursor.contains(start) && cursor.contains(finish))
+    ReceivedFrame frame;
+    auto &worker = CanSat::IngestionWorker::instance();
+    for (int i = 0; i < MAX_FRAMES_PER_UPDATE && worker.takeFrame(frame); ++i)
     {
-        // Remove the part of the buffer prior to, and including, the start sequence.
-        auto sIndex = cursor.indexOf(start);
-        cursor = cursor.mid(sIndex + start.length(), -1);
-        bytes += sIndex + start.length();
+        // Measure command latency
+        if (frame.valid && frame.type == ReceivedFrame::Container)
+        {
+            if (m_latency.echoReceived(frame.container.cmdEcho.view(), frame.steadyTime))
+                m_latencyChanged = true;
+        }
 
-        // Copy a sub-buffer that goes until the finish sequence
-        auto fIndex = cursor.indexOf(finish);
-        auto frame = cursor.left(fIndex);
+        // Display frame (decoded to text by the console if it is shown)
+        Misc::Console::instance().appendData(RX_PREFIX, frame.data);
+    }
 
-        // Process frame data
-        processFrame(frame);
+    // Notify user about frames that were logged, but not displayed
+    const auto dropped = worker.droppedFrames();
+    if (dropped != m_droppedFrames)
+    {
+        Q_EMIT printLn(QString("[WARN] %1 frames logged without being displayed")
+                           .arg(dropped - m_droppedFrames));
+        m_droppedFrames = dropped;
+    }
+}
 
-        // Remove the data including the finish sequence from the master buffer
-        cursor = cursor.mid(fIndex, -1);
-        bytes += fIndex + finish.length();
+/**
+ * Alerts the user about errors reported by the ingestion thread
+ */
+void CanSat::ControlPanel::onIngestionError(const QString &title, const QString &text)
+{
+    Misc::Notifications::instance().post(Misc::Notifications::Critical, title, text);
+}
+
+/**
+ * Stops sending simulated pressure readings & reports the timing statistics of the
+ * simulation scheduler
+ */
+void CanSat::ControlPanel::stopSimulationScheduler()
+{
+    if (!m_simulation.isRunning())
+        return;
+
+    m_simulation.stop();
+    if (m_simulation.ticks() > 0)
+    {
+        const auto &jitter = m_simulation.jitter();
+        Q_EMIT printLn(QString("[INFO] Simulation sent %1 readings at %2 Hz, %3 skipped, "
+                               "jitter p50 %4 ms, p99 %5 ms, max %6 ms")
+                           .arg(m_simulation.ticks())
+                           .arg(m_simulation.rate())
+                           .arg(m_simulation.skippedTicks())
+                           .arg(jitter.percentile(50) / 1000.0)
+                           .arg(jitter.percentile(99) / 1000.0)
+                           .arg(jitter.max() / 1000.0));
     }
+}
 
-    // Remove parsed data from master buffer
-    m_dataBuffer.remove(0, bytes);
+/**
+ * Notifies the user interface about new command latency measurements
+ */
+void CanSat::ControlPanel::updateCommandLatency()
+{
+    if (m_latencyChanged)
+    {
+        m_latencyChanged = false;
+        Q_EMIT commandLatencyChanged();
+    }
+}
+
+/**
+ * Writes the command latency statistics of the session to a JSON file, next to the
+ * CSV files of the current day
+ */
+void CanSat::ControlPanel::writeLatencySummary()
+{
+    // Nothing to write
+    if (m_latency.isEmpty())
+        return;
 
-    // Clear temp. buffer (e.g. device sends a lot of invalid data)
-    if (m_dataBuffer.size() > 1024 * 10 * 10)
-        m_dataBuffer.clear();
+    // Get path
+    const auto dateTime = QDateTime::currentDateTime();
+    const auto dir = IngestionWorker::logDirectory(dateTime);
+
+    // Write summary
+    auto summary = m_latency.summary();
+    summary.insert("date", dateTime.toString(Qt::ISODate));
+    QFile file(dir.filePath("Latency_" + dateTime.toString("HH-mm-ss") + ".json"));
+    if (file.open(QFile::WriteOnly))
+        file.write(QJsonDocument(summary).toJson());
 }
 
 /**
@@ -339,109 +514,46 @@ void CanSat::ControlPanel::updateCurrentTime()
 /**
  * Reads, validates & sends current simulated pressure reading to the CanSat.
  *
- * If we reach the last CSV row, then simulation mode shall be disabled & a message-box
- * shall be shown to the user.
+ * This function is called by the simulation scheduler on every tick, the CSV row is
+ * given by the tick @a index so that ticks dropped by the scheduler also skip their
+ * readings. If we reach the last CSV row, then simulation mode shall be disabled & a
+ * notification shall be shown to the user.
  */
-void CanSat::ControlPanel::sendSimulatedData()
+void CanSat::ControlPanel::sendSimulatedData(const quint64 index)
 {
     // Stop if simulation mode is not active
     if (!simulationActivated() || !SerialStudio::Plugin::instance().isConnected())
+    {
+        stopSimulationScheduler();
         return;
+    }
 
-    // Read, validate & send current row data
-    if (m_row < m_csvData.count() && m_row >= 0)
+    // Send current pressure reading
+    m_row = static_cast<int>(qMin<quint64>(index, m_profile.count()));
+    if (m_row < m_profile.count())
     {
-        // Get CSV row data
-        auto row = m_csvData.at(m_row);
-
-        // Generate row string
-        QString cmd = "CMD,1099,SIMP,";
-        cmd.append(row.first());
-        cmd.append(";");
-
-        // Send command
-        if (!cmd.isEmpty())
-            sendData(cmd);
-
-        // Column count invalid
-        else
-            Misc::Utilities::showMessageBox(
-                tr("Simulation CSV error"),
-                tr("Invalid column count at row %1").arg(m_row));
-
-        // Increment row
-        ++m_row;
-
-        // Llamar esta funcion en un segundo
-        QTimer::singleShot(1000, this, SLOT(sendSimulatedData()));
+        const auto pressure = QString::number(m_profile.at(m_row));
+        sendData("CMD,1099,SIMP," + pressure + ";", CommandQueue::Simulation);
     }
 
     // Show CSV finished box & disable simulation mode
     else
     {
+        stopSimulationScheduler();
         setSimulationActivated(false);
-        Misc::Utilities::showMessageBox(tr("Pressure simulation finished"),
-                                        tr("Reached end of CSV file"));
-        m_row = 1;
+        Misc::Notifications::instance().post(Misc::Notifications::Info,
+                                             tr("Pressure simulation finished"),
+                                             tr("Reached end of CSV file"));
+        m_row = 0;
     }
 }
 
 /**
- * Writes the data of the given @a frame to its associated CSV file
+ * Queues the given @a data string with the given @a priority, the command queue sends
+ * it to Serial Studio, which in turn sends the data through the serial port.
  */
-void CanSat::ControlPanel::processFrame(const QByteArray &frame)
-{
-    // Validate frame
-    if (frame.isEmpty())
-        return;
-
-    // Frame begins with 6026
-    if (frame.startsWith(QString("6026").toUtf8()))
-    {
-        // File is not open, create it
-        if (!m_payloadCsv.isOpen())
-        {
-            if (!createCsv(false))
-            {
-                Misc::Utilities::showMessageBox(tr("Error while creating payload CSV"),
-                                                m_payloadCsv.errorString());
-                return;
-            }
-        }
-
-        // Escribir datos al CSV
-        m_payloadCsv.write(frame);
-        m_payloadCsv.write("\n");
-    }
-
-    // Frame begins with 1099
-    else if (frame.startsWith(QString("1099").toUtf8()))
-    {
-        // File is not open, create it
-        if (!m_containerCsv.isOpen())
-        {
-            if (!createCsv(true))
-            {
-                Misc::Utilities::showMessageBox(tr("Error while creating container CSV"),
-                                                m_containerCsv.errorString());
-                return;
-            }
-        }
-
-        // Escribir datos al CSV
-        m_containerCsv.write(frame);
-        m_containerCsv.write("\n");
-    }
-
-    // Update user interface
-    Q_EMIT printLn("  [RX] " + QString::fromUtf8(frame));
-}
-
-/**
- * Sends the given @a data string to Serial Studio, which in turn sends the data through
- * the serial port.
- */
-bool CanSat::ControlPanel::sendData(const QString &data)
+bool CanSat::ControlPanel::sendData(const QString &data,
+                                    const CommandQueue::Priority priority)
 {
     // Data is empty, abort
     if (data.isEmpty())
@@ -451,107 +563,6 @@ bool CanSat::ControlPanel::sendData(const QString &data)
     if (!SerialStudio::Plugin::instance().isConnected())
         return false;
 
-    // Define Xbee 64-bit destination address
-    QByteArray address64bit;
-    // address64bit.append((quint8)0x00); // 0x7D in XCTU
-    address64bit.append((quint8)0x13);
-    address64bit.append((quint8)0xA2);
-    address64bit.append((quint8)0x00);
-    address64bit.append((quint8)0x41);
-    address64bit.append((quint8)0x83);
-    address64bit.append((quint8)0xA6);
-    address64bit.append((quint8)0x26);
-
-    // Define Xbee 16-bit address
-    QByteArray address16bit;
-    address16bit.append((quint8)0xFF);
-    address16bit.append((quint8)0xFE);
-
-    // Begin constructing Xbee API frame     -Don't move-
-    QByteArray frame;
-    frame.append((quint8)0x10); // Transmit request
-    frame.append((quint8)0x01); // No acknowledgement
-    frame.append((quint8)0x00); // Frame ID
-    frame.append(address64bit); // 64-bit destination address
-    frame.append(address16bit); // 16-bit destination address
-    frame.append((quint8)0x00); // Broadcast radio
-    frame.append((quint8)0x00); // Options
-
-    // Add data to frame
-    frame.append(data.toUtf8());
-
-    // Calculate sum
-    quint16 sum = 0;
-    for (auto i = 0; i < frame.length(); ++i)
-        sum += (quint8)frame[i];
-
-    // Calculate checksum
-    quint8 crc = 0xff - ((sum)&0xFF);
-
-    // Calculate frame length
-    quint16 length = frame.length();
-
-    // Replace first two bytes of 64-bit address after the CRC is calculated,
-    // for some unknown reason, the CRC needs to be calculated with non-MSB bytes
-    //    QByteArray msbAddress;
-    //  msbAddress.append((quint8)0x13);
-    // msbAddress.append((quint8)0xA2);
-    // frame = frame.replace(3, 2, msbAddress);
-
-    // Generate full frame   -Don't move-
-    QByteArray apiFrame;
-    apiFrame.append((quint8)0x7E);
-    apiFrame.append((quint8)((length) >> 8) & 0xff);
-    apiFrame.append((quint8)((length) >> 0) & 0xff);
-    apiFrame.append(frame);
-    apiFrame.append((quint8)crc);
-
-    //  qDebug() << apiFrame.toHex(); //imprime el hexadecimal de envio a XBee
-
-    // Send data to Serial Studio
-    Q_EMIT printLn("  [TX] " + data);
-    return SerialStudio::Plugin::instance().write(apiFrame);
-}
-
-/**
- * Creates a new CSV file with current date/time, the filaname of the created
- * CSV file depends on the value of @a createContainerCsv
- */
-bool CanSat::ControlPanel::createCsv(const bool createContainerCsv)
-{
-    // Get current date time
-    const auto dateTime = QDateTime::currentDateTime();
-
-    // Get file name
-    const QString title = createContainerCsv ? "Container" : "Payload";
-    const QString fileName = title + "_" + dateTime.toString("HH-mm-ss") + ".csv";
-
-    // Get path
-    const QString format = dateTime.toString("yyyy/MMM/dd/");
-    const QString path = QString("%1/Documents/%2/%3")
-                             .arg(QDir::homePath(), qApp->applicationName(), format);
-
-    // Generate file path if required
-    QDir dir(path);
-    if (!dir.exists())
-        dir.mkpath(".");
-
-    // Update UI
-    Q_EMIT printLn("[INFO] Creating new CSV file at " + dir.filePath(fileName));
-
-    // Create container CSV file
-    if (createContainerCsv)
-    {
-        m_containerCsv.close();
-        m_containerCsv.setFileName(dir.filePath(fileName));
-        return m_containerCsv.open(QFile::WriteOnly);
-    }
-
-    // Create payload CSV file
-    else
-    {
-        m_payloadCsv.close();
-        m_payloadCsv.setFileName(dir.filePath(fileName));
-        return m_payloadCsv.open(QFile::WriteOnly);
-    }
+    // Queue command
+    return m_commands.enqueue(data, priority);
 }
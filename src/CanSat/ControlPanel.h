@@ -25,6 +25,11 @@
 #include <QFile>
 #include <QObject>
 
+#include <CanSat/CommandQueue.h>
+#include <CanSat/LatencyTracker.h>
+#include <CanSat/SimulationProfile.h>
+#include <CanSat/SimulationScheduler.h>
+
 namespace CanSat
 {
 class ControlPanel : public QObject
@@ -52,6 +57,15 @@ class ControlPanel : public QObject
     Q_PROPERTY(bool simulationCsvLoaded
                    READ simulationCsvLoaded
                        NOTIFY csvFileNameChanged)
+    Q_PROPERTY(QVariantList commandLatency
+                   READ commandLatency
+                       NOTIFY commandLatencyChanged)
+    Q_PROPERTY(QVariantList deliveryLatency
+                   READ deliveryLatency
+                       NOTIFY commandLatencyChanged)
+    Q_PROPERTY(bool serialStudioConnected
+                   READ serialStudioConnected
+                       NOTIFY serialStudioConnectedChanged)
     // clang-format on
 
 Q_SIGNALS:
@@ -61,6 +75,8 @@ Q_SIGNALS:
     void printLn(const QString &line);
     void simulationActivatedChanged();
     void containerTelemetryEnabledChanged();
+    void commandLatencyChanged();
+    void serialStudioConnectedChanged();
 
 private:
     ControlPanel();
@@ -80,9 +96,13 @@ public:
     QString currentTime() const;
     QString csvFileName() const;
     bool simulationCsvLoaded() const;
+    QVariantList commandLatency() const;
+    QVariantList deliveryLatency() const;
+    bool serialStudioConnected() const;
 
 public slots:
     void openCsv();
+    bool loadProfile(const QString &fileName);
     void updateContainerTime();
     void updateContainerTimeGPS();
     void calibrateAltitude();
@@ -92,25 +112,31 @@ public slots:
 
 private slots:
     void updateCurrentTime();
-    void sendSimulatedData();
-    void processFrame(const QByteArray &frame);
-    void onDataReceived(const QByteArray &data);
+    void processFrames();
+    void sendSimulatedData(const quint64 index);
+    void onIngestionError(const QString &title, const QString &text);
+    void updateCommandLatency();
+    void writeLatencySummary();
+    void stopSimulationScheduler();
+    void restoreLastProfile();
+    void onPluginConnectedChanged();
 
 private:
-    bool sendData(const QString &data);
-    bool createCsv(const bool isContainer);
+    bool sendData(const QString &data,
+                  const CommandQueue::Priority priority = CommandQueue::Control);
 
 private:
     int m_row;
-    QFile m_file;
-    QFile m_tempFile;
     QString m_currentTime;
-    QByteArray m_dataBuffer;
-    QList<QStringList> m_csvData;
+    quint64 m_droppedFrames;
+    SimulationProfile m_profile;
 
-    QFile m_payloadCsv;
-    QFile m_containerCsv;
+    CommandQueue m_commands;
+    SimulationScheduler m_simulation;
+    LatencyTracker m_latency;
+    bool m_latencyChanged;
 
+    bool m_serialStudioConnected;
     bool m_simulationEnabled;
     bool m_simulationActivated;
     bool m_containerTelemetryEnabled;
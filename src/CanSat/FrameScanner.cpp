@@ -0,0 +1,140 @@
+/*
+ * Copyright (c) 2022 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "FrameScanner.h"
+
+#include <QtGlobal>
+
+#include <Misc/StreamBuffer.h>
+
+/*
+ * Start & finish sequences of each frame
+ */
+static constexpr QByteArrayView START_SEQUENCE("/*");
+static constexpr QByteArrayView FINISH_SEQUENCE("*/");
+
+/*
+ * Unparsed data is dropped if it grows beyond this size (e.g. the device sends a lot
+ * of invalid data without any frame delimiters).
+ */
+static constexpr qsizetype MAX_PENDING_BYTES = 1024 * 10 * 10;
+
+/**
+ * Constructor function
+ */
+CanSat::FrameScanner::FrameScanner()
+    : m_readPos(0)
+    , m_scanPos(0)
+    , m_frameStart(-1)
+{
+}
+
+/**
+ * Discards all buffered data & resets the state of the scanner
+ */
+void CanSat::FrameScanner::clear()
+{
+    m_buffer.clear();
+    m_readPos = 0;
+    m_scanPos = 0;
+    m_frameStart = -1;
+}
+
+/**
+ * Returns the number of buffered bytes that have not been consumed by a frame yet
+ */
+qsizetype CanSat::FrameScanner::pendingBytes() const
+{
+    return m_buffer.size() - m_readPos;
+}
+
+/**
+ * Adds the given @a data to the scanner buffer.
+ *
+ * The size limit only applies to the data that remained unparsed after the previous
+ * data was scanned, the new data is always kept. This way, a large chunk does not
+ * discard the partial frame whose tail it carries.
+ *
+ * Any frame view obtained with @c next() before calling this function becomes
+ * invalid.
+ */
+void CanSat::FrameScanner::append(QByteArrayView data)
+{
+    // Drop the unparsed remainder if it grew too much
+    if (pendingBytes() > MAX_PENDING_BYTES)
+        clear();
+
+    // Discard consumed data from time to time
+    const auto removed = Misc::StreamBuffer::compact(m_buffer, m_readPos);
+    m_readPos -= removed;
+    m_scanPos -= removed;
+    if (m_frameStart >= 0)
+        m_frameStart -= removed;
+
+    // Add data to buffer
+    m_buffer.append(data.data(), data.size());
+}
+
+/**
+ * Looks for the next complete frame in the buffer, starting from the position where
+ * the previous search stopped.
+ *
+ * If a frame is found, @a frame is set to a view of its contents (without the start
+ * and finish sequences) and @c true is returned. Otherwise, the scanner keeps its
+ * current state so that the search continues when more data is appended.
+ */
+bool CanSat::FrameScanner::next(QByteArrayView &frame)
+{
+    // Find the start sequence if we are not inside a frame
+    if (m_frameStart < 0)
+    {
+        const auto sIndex = m_buffer.indexOf(START_SEQUENCE, m_scanPos);
+        if (sIndex < 0)
+        {
+            // Nothing but the last byte can belong to a future start sequence
+            m_scanPos = qMax(m_readPos, m_buffer.size() - START_SEQUENCE.size() + 1);
+            m_readPos = m_scanPos;
+            return false;
+        }
+
+        m_readPos = sIndex;
+        m_frameStart = sIndex + START_SEQUENCE.size();
+        m_scanPos = m_frameStart;
+    }
+
+    // Find the finish sequence of the current frame
+    const auto fIndex = m_buffer.indexOf(FINISH_SEQUENCE, m_scanPos);
+    if (fIndex < 0)
+    {
+        // Resume the search at the last byte, it may be part of the finish sequence
+        const auto resume = m_buffer.size() - FINISH_SEQUENCE.size() + 1;
+        m_scanPos = qMax(m_frameStart, resume);
+        return false;
+    }
+
+    // Obtain frame view & move over the finish sequence
+    frame = QByteArrayView(m_buffer.constData() + m_frameStart, fIndex - m_frameStart);
+    m_readPos = fIndex + FINISH_SEQUENCE.size();
+    m_scanPos = m_readPos;
+    m_frameStart = -1;
+    return true;
+}
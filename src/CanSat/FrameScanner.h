@@ -0,0 +1,61 @@
+/*
+ * Copyright (c) 2022 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#pragma once
+
+#include <QByteArray>
+#include <QByteArrayView>
+
+namespace CanSat
+{
+/**
+ * @brief The FrameScanner class
+ *
+ * Extracts the frames delimited by the slash-asterisk start sequence and the
+ * asterisk-slash finish sequence from an incoming byte stream.
+ *
+ * The scanner remembers how far it has read between calls, so that every received
+ * byte is only inspected once, and it returns frames as views into its own buffer
+ * instead of copying them. Consumed data is discarded only when it makes up a
+ * significant part of the buffer, which keeps the cost of ingesting large bursts of
+ * frames linear with the amount of received data.
+ *
+ * @note Frame views are valid until the next call to @c append() or @c clear().
+ */
+class FrameScanner
+{
+public:
+    FrameScanner();
+
+    void clear();
+    qsizetype pendingBytes() const;
+
+    void append(QByteArrayView data);
+    bool next(QByteArrayView &frame);
+
+private:
+    QByteArray m_buffer;
+    qsizetype m_readPos;
+    qsizetype m_scanPos;
+    qsizetype m_frameStart;
+};
+}
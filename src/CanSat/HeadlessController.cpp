@@ -0,0 +1,506 @@
+/*
+ * Copyright (c) 2022 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "HeadlessController.h"
+
+#include <QSettings>
+#include <QCoreApplication>
+
+#include <mutex>
+#include <memory>
+#include <thread>
+#include <cstdio>
+#include <iostream>
+
+#ifdef Q_OS_UNIX
+#    include <cerrno>
+#    include <unistd.h>
+#endif
+
+#include <Misc/Console.h>
+#include <Misc/Notifications.h>
+#include <CanSat/ControlPanel.h>
+#include <CanSat/IngestionWorker.h>
+#include <SerialStudio/Plugin.h>
+
+/*
+ * Help text of the control commands
+ */
+static const QString HELP_TEXT = QStringLiteral(
+    "Commands:\n"
+    "  status                           Show connection & simulation status\n"
+    "  load <file>                      Load a simulation profile\n"
+    "  simulation <on|off|start|stop>   Enable, disable, activate or stop simulation\n"
+    "  telemetry <on|off>               Enable or disable container telemetry\n"
+    "  time [gps]                       Set container time (UTC or GPS)\n"
+    "  calibrate                        Calibrate altitude\n"
+    "  latency                          Show command latency statistics\n"
+    "  history                          Show telemetry history statistics\n"
+    "  quit                             Stop the ground station");
+
+/*
+ * Time to wait for a running instance to accept a probe connection, in milliseconds
+ */
+static constexpr int PROBE_TIMEOUT = 1000;
+
+/*
+ * Describes the frames kept in the given telemetry @a history: number of frames, time
+ * span & altitude range
+ */
+template<typename Frame>
+static QString describeHistory(const QString &name,
+                               const CanSat::TelemetryHistory<Frame> &history)
+{
+    if (history.isEmpty())
+        return name + ": no frames received yet";
+
+    // Get altitude range, segment by segment
+    constexpr auto ALTITUDE = CanSat::fieldIndex<Frame>("ALTITUDE");
+    const auto altitude = history.template column<ALTITUDE>();
+    auto min = altitude[0];
+    auto max = altitude[0];
+    const auto scan = [&](const float *values, const std::size_t size) {
+        for (std::size_t i = 0; i < size; ++i)
+        {
+            min = qMin(min, values[i]);
+            max = qMax(max, values[i]);
+        }
+    };
+
+    scan(altitude.first, altitude.firstSize);
+    scan(altitude.second, altitude.secondSize);
+
+    // Get time span
+    const auto timestamps = history.timestamps();
+    const auto span = timestamps[timestamps.size() - 1] - timestamps[0];
+    return QString("%1: %2 of %3 frames over %4 s, altitude %5 to %6 m (last %7 m)")
+        .arg(name)
+        .arg(history.size())
+        .arg(history.capacity())
+        .arg(span / 1000.0)
+        .arg(min)
+        .arg(max)
+        .arg(altitude[altitude.size() - 1]);
+}
+
+/**
+ * Constructor function
+ */
+CanSat::HeadlessController::HeadlessController()
+    : m_stdinNotifier(nullptr)
+{
+    connect(&m_server, &QLocalServer::newConnection, this,
+            &CanSat::HeadlessController::onNewConnection);
+}
+
+/**
+ * Returns a pointer to the only instance of the class
+ */
+CanSat::HeadlessController &CanSat::HeadlessController::instance()
+{
+    static HeadlessController singleton;
+    return singleton;
+}
+
+/**
+ * Prints console lines & notifications, starts reading commands from the standard
+ * input & opens the local control socket with the given @a serverName (or the
+ * @c Headless/ServerName setting if it is empty).
+ *
+ * Returns @c false if the control socket cannot be opened, commands are still read
+ * from the standard input in that case.
+ */
+bool CanSat::HeadlessController::start(const QString &serverName)
+{
+    // Print console lines
+    connect(&Misc::Console::instance(), &Misc::Console::linesPublished, this,
+            &CanSat::HeadlessController::printLines);
+
+    // Print notifications
+    connect(&Misc::Notifications::instance(), &Misc::Notifications::posted, this,
+            [=](const Misc::Notifications::Level level, const QString &title,
+                const QString &text) {
+                auto tag = "INFO";
+                if (level == Misc::Notifications::Warning)
+                    tag = "WARN";
+                else if (level == Misc::Notifications::Critical)
+                    tag = "ERROR";
+
+                print(QString(" [Notification] [%1] %2: %3").arg(tag, title, text));
+            });
+
+    // Read commands from the standard input
+    watchStandardInput();
+
+    // Get control socket name
+    auto name = serverName;
+    if (name.isEmpty())
+        name = QSettings().value("Headless/ServerName", "CC2022-Control").toString();
+
+    // Open control socket
+    if (!listen(name))
+    {
+        print(" [Headless] [WARN] Cannot open control socket " + name + ": "
+              + m_server.errorString());
+        return false;
+    }
+
+    print(" [Headless] [INFO] Listening for commands on " + m_server.fullServerName());
+    return true;
+}
+
+/**
+ * Starts reading commands from the standard input, one command per line.
+ *
+ * On Unix, the standard input is watched by the event loop. Elsewhere, a detached
+ * thread blocks while waiting for input; it stops forwarding commands once the
+ * application is about to quit, so that it never posts to this object after
+ * @c main() returns.
+ */
+void CanSat::HeadlessController::watchStandardInput()
+{
+#ifdef Q_OS_UNIX
+    m_stdinNotifier = new QSocketNotifier(STDIN_FILENO, QSocketNotifier::Read, this);
+    connect(m_stdinNotifier, &QSocketNotifier::activated, this,
+            &CanSat::HeadlessController::readStandardInput);
+#else
+    struct Guard
+    {
+        std::mutex mutex;
+        bool open = true;
+    };
+
+    auto guard = std::make_shared<Guard>();
+    connect(qApp, &QCoreApplication::aboutToQuit, this, [guard] {
+        std::lock_guard<std::mutex> lock(guard->mutex);
+        guard->open = false;
+    });
+
+    std::thread([this, guard] {
+        std::string line;
+        while (std::getline(std::cin, line))
+        {
+            std::lock_guard<std::mutex> lock(guard->mutex);
+            if (!guard->open)
+                return;
+
+            const auto command = QString::fromStdString(line);
+            QMetaObject::invokeMethod(
+                this, [=] { processCommand(command, nullptr); }, Qt::QueuedConnection);
+        }
+    }).detach();
+#endif
+}
+
+/**
+ * Reads the available data of the standard input & processes every complete line,
+ * stops watching the standard input once it is closed
+ */
+void CanSat::HeadlessController::readStandardInput()
+{
+#ifdef Q_OS_UNIX
+    // Read available data
+    char buffer[4096];
+    const auto bytes = ::read(STDIN_FILENO, buffer, sizeof(buffer));
+    if (bytes < 0 && errno == EINTR)
+        return;
+
+    // End of input or read error
+    if (bytes <= 0)
+    {
+        m_stdinNotifier->setEnabled(false);
+        return;
+    }
+
+    // Process complete lines
+    m_stdinBuffer.append(buffer, bytes);
+    qsizetype end;
+    while ((end = m_stdinBuffer.indexOf('\n')) >= 0)
+    {
+        const auto command = QString::fromUtf8(m_stdinBuffer.left(end));
+        m_stdinBuffer.remove(0, end + 1);
+        processCommand(command, nullptr);
+    }
+#endif
+}
+
+/**
+ * Opens the control socket with the given @a name. If the name is in use, a probe
+ * connection checks whether another instance is running: its socket is left alone,
+ * while stale sockets left by a crashed instance are removed.
+ */
+bool CanSat::HeadlessController::listen(const QString &name)
+{
+    // Open control socket
+    m_server.setSocketOptions(QLocalServer::UserAccessOption);
+    if (m_server.listen(name))
+        return true;
+
+    // Another instance is listening on the socket
+    QLocalSocket probe;
+    probe.connectToServer(name);
+    if (probe.waitForConnected(PROBE_TIMEOUT))
+    {
+        probe.disconnectFromServer();
+        return false;
+    }
+
+    // Remove stale socket & try again
+    QLocalServer::removeServer(name);
+    return m_server.listen(name);
+}
+
+/**
+ * Writes the given @a line to the standard output & to every connected client
+ */
+void CanSat::HeadlessController::print(const QString &line)
+{
+    printLines(QStringList { line });
+}
+
+/**
+ * Writes the given @a lines to the standard output & to every connected client
+ */
+void CanSat::HeadlessController::printLines(const QStringList &lines)
+{
+    // Join lines
+    auto data = lines.join('\n').toUtf8();
+    data.append('\n');
+
+    // Write to the standard output
+    std::fwrite(data.constData(), 1, data.size(), stdout);
+    std::fflush(stdout);
+
+    // Write to connected clients
+    for (auto client : qAsConst(m_clients))
+        client->write(data);
+}
+
+/**
+ * Registers the clients that connect to the control socket
+ */
+void CanSat::HeadlessController::onNewConnection()
+{
+    while (m_server.hasPendingConnections())
+    {
+        auto client = m_server.nextPendingConnection();
+        connect(client, &QLocalSocket::readyRead, this,
+                &CanSat::HeadlessController::onClientReadyRead);
+        connect(client, &QLocalSocket::disconnected, this,
+                &CanSat::HeadlessController::onClientDisconnected);
+
+        m_clients.append(client);
+        reply(client, QString("%1 %2 ready, type \"help\" for a list of commands")
+                          .arg(qApp->applicationName(), qApp->applicationVersion()));
+    }
+}
+
+/**
+ * Processes the commands received from a client of the control socket, one command
+ * per line
+ */
+void CanSat::HeadlessController::onClientReadyRead()
+{
+    auto client = qobject_cast<QLocalSocket *>(sender());
+    if (!client)
+        return;
+
+    while (client->canReadLine())
+        processCommand(QString::fromUtf8(client->readLine()), client);
+}
+
+/**
+ * Unregisters clients that disconnect from the control socket
+ */
+void CanSat::HeadlessController::onClientDisconnected()
+{
+    auto client = qobject_cast<QLocalSocket *>(sender());
+    if (!client)
+        return;
+
+    m_clients.removeAll(client);
+    client->deleteLater();
+}
+
+/**
+ * Executes the given @a command & sends the reply to the @a client that issued it
+ * (or to the standard output if @a client is @c nullptr)
+ */
+void CanSat::HeadlessController::processCommand(const QString &command,
+                                                QLocalSocket *client)
+{
+    // Split command & argument
+    const auto line = command.trimmed();
+    const auto name = line.section(' ', 0, 0).toLower();
+    const auto arg = line.section(' ', 1).trimmed();
+    if (name.isEmpty())
+        return;
+
+    // Get modules
+    auto &panel = CanSat::ControlPanel::instance();
+    auto &plugin = SerialStudio::Plugin::instance();
+
+    // Show help
+    if (name == "help")
+        reply(client, HELP_TEXT);
+
+    // Show status
+    else if (name == "status")
+    {
+        const auto yesNo = [](const bool value) { return value ? "yes" : "no"; };
+        const auto suppressed = Misc::Console::instance().suppressedLines();
+        reply(client, QString("Serial Studio connected: %1\n"
+                              "Simulation profile: %2\n"
+                              "Simulation enabled: %3\n"
+                              "Simulation activated: %4\n"
+                              "Container telemetry: %5\n"
+                              "Console lines suppressed: %6")
+                          .arg(yesNo(plugin.isConnected()), panel.csvFileName(),
+                               yesNo(panel.simulationEnabled()),
+                               yesNo(panel.simulationActivated()),
+                               yesNo(panel.containerTelemetryEnabled()),
+                               QString::number(suppressed)));
+    }
+
+    // Load simulation profile
+    else if (name == "load")
+    {
+        if (arg.isEmpty())
+            reply(client, "Usage: load <file>");
+        else if (panel.loadProfile(arg))
+            reply(client, "OK");
+        else
+            reply(client, "Cannot load " + arg);
+    }
+
+    // Control simulation mode
+    else if (name == "simulation")
+    {
+        if (!plugin.isConnected())
+            reply(client, "Serial Studio is not connected");
+        else if (arg == "on")
+            panel.setSimulationMode(true);
+        else if (arg == "off" || arg == "stop")
+            panel.setSimulationMode(false);
+        else if (arg == "start" && !panel.simulationCsvLoaded())
+            reply(client, "No simulation profile loaded");
+        else if (arg == "start" && !panel.simulationEnabled())
+            reply(client, "Simulation mode is not enabled");
+        else if (arg == "start")
+            panel.setSimulationActivated(true);
+        else
+            reply(client, "Usage: simulation <on|off|start|stop>");
+    }
+
+    // Control container telemetry
+    else if (name == "telemetry")
+    {
+        if (!plugin.isConnected())
+            reply(client, "Serial Studio is not connected");
+        else if (arg == "on" || arg == "off")
+            panel.setContainerTelemetryEnabled(arg == "on");
+        else
+            reply(client, "Usage: telemetry <on|off>");
+    }
+
+    // Set container time
+    else if (name == "time")
+    {
+        if (arg == "gps")
+            panel.updateContainerTimeGPS();
+        else
+            panel.updateContainerTime();
+    }
+
+    // Calibrate altitude
+    else if (name == "calibrate")
+        panel.calibrateAltitude();
+
+    // Show command latency
+    else if (name == "latency")
+    {
+        const auto statistics = panel.commandLatency();
+        if (statistics.isEmpty())
+            reply(client, "No command echoes received yet");
+
+        for (const auto &item : statistics)
+        {
+            const auto map = item.toMap();
+            reply(client, QString("%1: n=%2 p50=%3 ms p99=%4 ms max=%5 ms")
+                              .arg(map.value("type").toString())
+                              .arg(map.value("count").toLongLong())
+                              .arg(map.value("p50").toDouble())
+                              .arg(map.value("p99").toDouble())
+                              .arg(map.value("max").toDouble()));
+        }
+
+        for (const auto &item : panel.deliveryLatency())
+        {
+            const auto map = item.toMap();
+            reply(client, QString("%1 delivery: n=%2 p50=%3 ms p99=%4 ms max=%5 ms")
+                              .arg(map.value("type").toString())
+                              .arg(map.value("count").toLongLong())
+                              .arg(map.value("p50").toDouble())
+                              .arg(map.value("p99").toDouble())
+                              .arg(map.value("max").toDouble()));
+        }
+    }
+
+    // Show telemetry history, the histories are locked while the text is generated
+    else if (name == "history")
+    {
+        QString payloadText;
+        QString containerText;
+        CanSat::IngestionWorker::instance().readHistory(
+            [&](const auto &payload, const auto &container) {
+                payloadText = describeHistory("Payload", payload);
+                containerText = describeHistory("Container", container);
+            });
+
+        reply(client, payloadText);
+        reply(client, containerText);
+    }
+
+    // Stop ground station
+    else if (name == "quit" || name == "exit")
+        qApp->quit();
+
+    // Unknown command
+    else
+        reply(client, "Unknown command \"" + name + "\", type \"help\" for help");
+}
+
+/**
+ * Sends the given @a text to the @a client that issued a command, or to the standard
+ * output if the command was read from the standard input
+ */
+void CanSat::HeadlessController::reply(QLocalSocket *client, const QString &text)
+{
+    if (client)
+        client->write(text.toUtf8() + '\n');
+    else
+    {
+        const auto data = text.toUtf8() + '\n';
+        std::fwrite(data.constData(), 1, data.size(), stdout);
+        std::fflush(stdout);
+    }
+}
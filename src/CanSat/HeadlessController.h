@@ -0,0 +1,85 @@
+/*
+ * Copyright (c) 2022 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#pragma once
+
+#include <QList>
+#include <QObject>
+#include <QLocalServer>
+#include <QLocalSocket>
+#include <QSocketNotifier>
+
+namespace CanSat
+{
+/**
+ * @brief The HeadlessController class
+ *
+ * Controls the ground station when the application runs without user interface
+ * (@c --headless command line option). Console lines & notifications are printed to
+ * the standard output, and the ground station is operated with text commands (see
+ * the @c help command) read from the standard input or from the clients of a local
+ * control socket (@c Headless/ServerName setting, @c CC2022-Control by default).
+ *
+ * Replies to a command are sent to the client that issued it, console lines are sent
+ * to the standard output & to every connected client, so that a local client can be
+ * used to monitor a backup ground station.
+ */
+class HeadlessController : public QObject
+{
+    // clang-format off
+    Q_OBJECT
+    // clang-format on
+
+private:
+    HeadlessController();
+    HeadlessController(HeadlessController &&) = delete;
+    HeadlessController(const HeadlessController &) = delete;
+    HeadlessController &operator=(HeadlessController &&) = delete;
+    HeadlessController &operator=(const HeadlessController &) = delete;
+
+public:
+    static HeadlessController &instance();
+
+public Q_SLOTS:
+    bool start(const QString &serverName = QString());
+    void print(const QString &line);
+    void printLines(const QStringList &lines);
+
+private Q_SLOTS:
+    void onNewConnection();
+    void onClientReadyRead();
+    void onClientDisconnected();
+    void processCommand(const QString &command, QLocalSocket *client);
+
+private:
+    void watchStandardInput();
+    void readStandardInput();
+    bool listen(const QString &name);
+    void reply(QLocalSocket *client, const QString &text);
+
+private:
+    QLocalServer m_server;
+    QList<QLocalSocket *> m_clients;
+    QSocketNotifier *m_stdinNotifier;
+    QByteArray m_stdinBuffer;
+};
+}
@@ -0,0 +1,484 @@
+/*
+ * Copyright (c) 2022 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "IngestionWorker.h"
+
+#include <QDir>
+#include <QDateTime>
+#include <QFileInfo>
+#include <QSettings>
+#include <QCoreApplication>
+
+#include <Misc/SteadyClock.h>
+#include <Misc/TimerEvents.h>
+#include <SerialStudio/Plugin.h>
+#include <CanSat/TelemetryDecoder.h>
+
+/*
+ * Memory used to keep the telemetry history of each frame type
+ */
+static constexpr std::size_t HISTORY_MEMORY_BUDGET = 8 * 1024 * 1024;
+
+/**
+ * Constructor function
+ */
+CanSat::IngestionWorker::IngestionWorker()
+    : m_apiMode(XBee::ApiMode::Transparent)
+    , m_apiInvalidFrames(0)
+    , m_apiDiscardedBytes(0)
+    , m_syncOnStateChange(true)
+    , m_payloadCsvLoss(0)
+    , m_containerCsvLoss(0)
+    , m_missionLogLoss(0)
+    , m_payloadHistory(HISTORY_MEMORY_BUDGET)
+    , m_containerHistory(HISTORY_MEMORY_BUDGET)
+    , m_droppedFrames(0)
+{
+    // Plugins comm signals/slots (both objects live in the ingestion thread)
+    auto pc = &(SerialStudio::Plugin::instance());
+    connect(pc, &SerialStudio::Plugin::dataReceived, this,
+            &CanSat::IngestionWorker::onDataReceived);
+
+    // Check the log writers once per second
+    auto te = &(Misc::TimerEvents::instance());
+    connect(te, &Misc::TimerEvents::timeout1Hz, this,
+            &CanSat::IngestionWorker::checkLogs);
+}
+
+/**
+ * Returns a pointer to the only instance of the class
+ */
+CanSat::IngestionWorker &CanSat::IngestionWorker::instance()
+{
+    static IngestionWorker singleton;
+    return singleton;
+}
+
+/**
+ * Returns the number of frames that were logged, but could not be published to the
+ * user interface because the frame queue was full.
+ */
+quint64 CanSat::IngestionWorker::droppedFrames() const
+{
+    return m_droppedFrames.load(std::memory_order_relaxed);
+}
+
+/**
+ * Returns the directory in which the files of a session started at the given
+ * @a dateTime are stored (Documents/<application name>/yyyy/MMM/dd), the directory
+ * is created if it does not exist.
+ */
+QDir CanSat::IngestionWorker::logDirectory(const QDateTime &dateTime)
+{
+    const QString format = dateTime.toString("yyyy/MMM/dd/");
+    const QString path
+        = QString("%1/Documents/%2/%3")
+              .arg(QDir::homePath(), QCoreApplication::applicationName(), format);
+
+    QDir dir(path);
+    if (!dir.exists())
+        dir.mkpath(".");
+
+    return dir;
+}
+
+/**
+ * Moves the oldest received frame to @a frame, returns @c false if there are no
+ * frames waiting to be displayed. Must only be called from the user interface thread.
+ */
+bool CanSat::IngestionWorker::takeFrame(ReceivedFrame &frame)
+{
+    return m_queue.pop(frame);
+}
+
+/**
+ * Moves the worker & the Serial Studio plugin to the ingestion thread and starts it.
+ * Must be called from the main thread.
+ */
+void CanSat::IngestionWorker::start()
+{
+    if (m_thread.isRunning())
+        return;
+
+    QSettings settings;
+    const auto mode = settings.value("XBee/ApiMode", 0).toInt();
+    m_apiMode = static_cast<XBee::ApiMode>(qBound(0, mode, 2));
+    m_apiDecoder.setEscaped(m_apiMode == XBee::ApiMode::ApiEscaped);
+
+    m_thread.setObjectName("Ingestion");
+    moveToThread(&m_thread);
+    SerialStudio::Plugin::instance().moveToThread(&m_thread);
+    m_thread.start();
+}
+
+/**
+ * Closes the log files, moves the worker & the Serial Studio plugin back to the main
+ * thread and stops the ingestion thread. Must be called from the main thread.
+ */
+void CanSat::IngestionWorker::stop()
+{
+    if (!m_thread.isRunning())
+        return;
+
+    QMetaObject::invokeMethod(this, &CanSat::IngestionWorker::finish,
+                              Qt::BlockingQueuedConnection);
+    m_thread.quit();
+    m_thread.wait();
+}
+
+/**
+ * Releases the resources owned by the ingestion thread, runs in the ingestion thread
+ */
+void CanSat::IngestionWorker::finish()
+{
+    m_payloadCsv.close();
+    m_containerCsv.close();
+    m_missionLog.close();
+    m_scanner.clear();
+    m_apiDecoder.clear();
+    m_payloadState = {};
+    m_containerState = {};
+
+    auto mainThread = QCoreApplication::instance()->thread();
+    SerialStudio::Plugin::instance().moveToThread(mainThread);
+    moveToThread(mainThread);
+}
+
+/**
+ * Reports the data that each log file lost & the data that the XBee API decoder
+ * rejected since the last check
+ */
+void CanSat::IngestionWorker::checkLogs()
+{
+    reportLogLoss(m_payloadCsv, m_payloadCsvLoss);
+    reportLogLoss(m_containerCsv, m_containerCsvLoss);
+    reportLogLoss(m_missionLog, m_missionLogLoss);
+    reportDecoderErrors();
+}
+
+/**
+ * Reads incoming data from Serial Studio
+ */
+void CanSat::IngestionWorker::onDataReceived(const QByteArray &data)
+{
+    QByteArrayView frame;
+
+    // Decode XBee API frames
+    if (m_apiMode != XBee::ApiMode::Transparent)
+    {
+        m_apiDecoder.append(data);
+        while (m_apiDecoder.next(frame))
+            processApiFrame(frame);
+    }
+
+    // Scan text frames directly
+    else
+    {
+        m_scanner.append(data);
+        while (m_scanner.next(frame))
+            processFrame(frame);
+    }
+}
+
+/**
+ * Sends the given XBee API @a frame to the handler of its frame type, frame types
+ * that are not used by the control panel are ignored
+ */
+void CanSat::IngestionWorker::processApiFrame(QByteArrayView frame)
+{
+    switch (static_cast<quint8>(frame.front()))
+    {
+        case XBee::ReceivePacket:
+            processReceivePacket(frame);
+            break;
+        case XBee::TransmitStatus:
+            processTransmitStatus(frame);
+            break;
+        default:
+            break;
+    }
+}
+
+/**
+ * Passes the RF data of a receive packet (0x90) frame to the text frame scanner
+ */
+void CanSat::IngestionWorker::processReceivePacket(QByteArrayView frame)
+{
+    if (frame.size() <= XBee::RECEIVE_PACKET_HEADER_SIZE)
+        return;
+
+    m_scanner.append(frame.sliced(XBee::RECEIVE_PACKET_HEADER_SIZE));
+
+    QByteArrayView textFrame;
+    while (m_scanner.next(textFrame))
+        processFrame(textFrame);
+}
+
+/**
+ * Reports the delivery status of a transmit request from a transmit status (0x8B)
+ * frame
+ */
+void CanSat::IngestionWorker::processTransmitStatus(QByteArrayView frame)
+{
+    // Frame type, frame ID, 16-bit address, retries, delivery & discovery status
+    if (frame.size() < 7)
+        return;
+
+    const auto frameId = static_cast<quint8>(frame.at(1));
+    const auto retries = static_cast<quint8>(frame.at(4));
+    const auto deliveryStatus = static_cast<quint8>(frame.at(5));
+    Q_EMIT transmitStatusReceived(frameId, retries, deliveryStatus);
+}
+
+/**
+ * Writes the data of the given @a frame to its associated CSV file & to the mission
+ * log, decodes its telemetry values, stores them in the telemetry history & publishes
+ * the frame to the user interface.
+ */
+void CanSat::IngestionWorker::processFrame(QByteArrayView frame)
+{
+    // Validate frame
+    if (frame.isEmpty())
+        return;
+
+    // Initialize frame data
+    bool stateChanged = false;
+    ReceivedFrame received;
+    received.timestamp = QDateTime::currentMSecsSinceEpoch();
+    received.steadyTime = Misc::SteadyClock::microseconds();
+
+    // Frame begins with 6026
+    if (frame.startsWith(Schema<PayloadTelemetry>::prefix))
+    {
+        // File is not open, create it
+        if (!m_payloadCsv.isOpen())
+        {
+            if (!createCsv(false))
+            {
+                Q_EMIT errorOccurred(tr("Error while creating payload CSV"),
+                                     m_payloadCsv.errorString());
+                return;
+            }
+        }
+
+        // Escribir datos al CSV
+        m_payloadCsv.appendLine(frame);
+
+        // Decode telemetry values
+        received.type = ReceivedFrame::Payload;
+        received.valid = TelemetryDecoder::decode(frame, received.payload);
+
+        // Check if the payload changed its state
+        if (received.valid && received.payload.state != m_payloadState)
+        {
+            m_payloadState = received.payload.state;
+            stateChanged = true;
+        }
+    }
+
+    // Frame begins with 1099
+    else if (frame.startsWith(Schema<ContainerTelemetry>::prefix))
+    {
+        // File is not open, create it
+        if (!m_containerCsv.isOpen())
+        {
+            if (!createCsv(true))
+            {
+                Q_EMIT errorOccurred(tr("Error while creating container CSV"),
+                                     m_containerCsv.errorString());
+                return;
+            }
+        }
+
+        // Escribir datos al CSV
+        m_containerCsv.appendLine(frame);
+
+        // Decode telemetry values
+        received.type = ReceivedFrame::Container;
+        received.valid = TelemetryDecoder::decode(frame, received.container);
+
+        // Check if the container changed its state
+        if (received.valid && received.container.state != m_containerState)
+        {
+            m_containerState = received.container.state;
+            stateChanged = true;
+        }
+    }
+
+    // Write frame to the mission log
+    switch (received.type)
+    {
+        case ReceivedFrame::Payload:
+            m_missionLog.append(MissionLogRecord::PayloadFrame, received.timestamp,
+                                frame);
+            break;
+        case ReceivedFrame::Container:
+            m_missionLog.append(MissionLogRecord::ContainerFrame, received.timestamp,
+                                frame);
+            break;
+        default:
+            m_missionLog.append(MissionLogRecord::UnknownFrame, received.timestamp,
+                                frame);
+            break;
+    }
+
+    // Store decoded telemetry
+    if (received.valid)
+    {
+        QMutexLocker locker(&m_historyMutex);
+        if (received.type == ReceivedFrame::Payload)
+            m_payloadHistory.append(received.timestamp, received.payload);
+        else
+            m_containerHistory.append(received.timestamp, received.container);
+    }
+
+    // Commit logs to disk when the CanSat changes its state
+    if (stateChanged && m_syncOnStateChange)
+    {
+        m_missionLog.sync();
+        if (received.type == ReceivedFrame::Payload)
+            m_payloadCsv.sync();
+        else
+            m_containerCsv.sync();
+    }
+
+    // Publish frame to the user interface
+    received.data = frame.toByteArray();
+    if (!m_queue.push(std::move(received)))
+        m_droppedFrames.fetch_add(1, std::memory_order_relaxed);
+}
+
+/**
+ * Creates a new CSV file with current date/time, the filaname of the created
+ * CSV file depends on the value of @a createContainerCsv
+ */
+bool CanSat::IngestionWorker::createCsv(const bool createContainerCsv)
+{
+    // Get current date time
+    const auto dateTime = QDateTime::currentDateTime();
+
+    // Get file name
+    const QString title = createContainerCsv ? "Container" : "Payload";
+    const QString fileName = title + "_" + dateTime.toString("HH-mm-ss") + ".csv";
+
+    // Get path
+    const auto dir = logDirectory(dateTime);
+
+    // Update UI
+    Q_EMIT printLn("[INFO] Creating new CSV file at " + dir.filePath(fileName));
+
+    // Read log flush policy
+    QSettings settings;
+    Misc::LogWriter::Policy policy;
+    policy.flushInterval = settings.value("Logging/FlushInterval", 1000).toInt();
+    policy.flushFrames = settings.value("Logging/FlushFrames", 0).toInt();
+    m_syncOnStateChange = settings.value("Logging/SyncOnStateChange", true).toBool();
+
+    // Create the mission log of this session
+    if (!m_missionLog.isOpen() && !createMissionLog(dir, dateTime, policy))
+    {
+        Q_EMIT errorOccurred(tr("Error while creating mission log"),
+                             m_missionLog.errorString());
+    }
+
+    // Create container CSV file
+    if (createContainerCsv)
+    {
+        m_containerCsv.setPolicy(policy);
+        return m_containerCsv.open(dir.filePath(fileName));
+    }
+
+    // Create payload CSV file
+    else
+    {
+        m_payloadCsv.setPolicy(policy);
+        return m_payloadCsv.open(dir.filePath(fileName));
+    }
+}
+
+/**
+ * Prints a warning if the given log @a writer lost data since the amount in
+ * @a reportedBytes was reported, and updates it. The user is also notified the first
+ * time that the log loses data, so that a full or failing disk does not go unnoticed
+ * (but is not reported every second).
+ */
+template<typename Writer>
+void CanSat::IngestionWorker::reportLogLoss(const Writer &writer, quint64 &reportedBytes)
+{
+    // Check if new data was lost
+    const auto failed = writer.failedBytes();
+    const auto dropped = writer.droppedBytes();
+    if (failed + dropped <= reportedBytes)
+        return;
+
+    // Describe the loss
+    auto text = tr("%1: %2 bytes dropped (disk too slow), %3 bytes not written")
+                    .arg(QFileInfo(writer.fileName()).fileName())
+                    .arg(dropped)
+                    .arg(failed);
+    if (failed > 0)
+        text += " (" + writer.writeErrorString() + ")";
+
+    // Report the loss
+    Q_EMIT printLn("[WARN] Log data lost, " + text);
+    if (reportedBytes == 0)
+        Q_EMIT errorOccurred(tr("Log data lost"), text);
+
+    reportedBytes = failed + dropped;
+}
+
+/**
+ * Prints a warning if the XBee API decoder rejected frames (invalid length or
+ * checksum) or discarded bytes outside of frames since the last check
+ */
+void CanSat::IngestionWorker::reportDecoderErrors()
+{
+    // Check if new data was rejected
+    const auto invalid = m_apiDecoder.invalidFrames();
+    const auto discarded = m_apiDecoder.discardedBytes();
+    if (invalid == m_apiInvalidFrames && discarded == m_apiDiscardedBytes)
+        return;
+
+    // Report the rejected data
+    Q_EMIT printLn(QString("[WARN] XBee API data rejected, %1 invalid frames & %2 "
+                           "discarded bytes (%3 & %4 in total)")
+                       .arg(invalid - m_apiInvalidFrames)
+                       .arg(discarded - m_apiDiscardedBytes)
+                       .arg(invalid)
+                       .arg(discarded));
+
+    m_apiInvalidFrames = invalid;
+    m_apiDiscardedBytes = discarded;
+}
+
+/**
+ * Creates the binary mission log of the current session in the given @a dir, next
+ * to the CSV files.
+ */
+bool CanSat::IngestionWorker::createMissionLog(const QDir &dir, const QDateTime &dateTime,
+                                               const Misc::LogWriter::Policy &policy)
+{
+    const QString fileName = "Mission_" + dateTime.toString("HH-mm-ss") + ".cclog";
+    const QString filePath = dir.filePath(fileName);
+    Q_EMIT printLn("[INFO] Creating new mission log at " + filePath);
+    return m_missionLog.open(filePath, policy);
+}
@@ -0,0 +1,179 @@
+/*
+ * Copyright (c) 2022 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#pragma once
+
+#include <QMutex>
+#include <QDir>
+#include <QThread>
+#include <QDateTime>
+#include <QObject>
+#include <QByteArray>
+
+#include <atomic>
+
+#include <Misc/LogWriter.h>
+#include <Misc/SpscQueue.h>
+#include <CanSat/Telemetry.h>
+#include <CanSat/MissionLog.h>
+#include <XBee/FrameDecoder.h>
+#include <CanSat/FrameScanner.h>
+#include <CanSat/TelemetryHistory.h>
+
+namespace CanSat
+{
+/**
+ * @brief Frame received from the CanSat & logged by the ingestion thread
+ *
+ * The typed telemetry member that corresponds to the frame @c type is only meaningful
+ * if @c valid is @c true. @c timestamp is the receive time in milliseconds since
+ * epoch, @c steadyTime is the receive time in steady clock microseconds.
+ */
+struct ReceivedFrame
+{
+    enum Type
+    {
+        Unknown,
+        Payload,
+        Container,
+    };
+
+    Type type = Unknown;
+    bool valid = false;
+    qint64 timestamp = 0;
+    qint64 steadyTime = 0;
+    QByteArray data;
+
+    PayloadTelemetry payload;
+    ContainerTelemetry container;
+};
+
+/**
+ * @brief The IngestionWorker class
+ *
+ * The @c IngestionWorker class runs the telemetry ingestion path in a dedicated
+ * thread. It owns the Serial Studio socket, the frame scanner, the CSV log files &
+ * the binary mission log, so that frames are received and logged regardless of what
+ * the user interface is doing. Log files are written in batches by their own writer
+ * threads, and committed to disk whenever the CanSat changes its flight state.
+ *
+ * Depending on the @c XBee/ApiMode setting, received data is either scanned for text
+ * frames directly (transparent mode) or decoded as XBee API frames first. In API mode,
+ * the RF data of receive packets (0x90) is passed to the text frame scanner & transmit
+ * status frames (0x8B) are reported with the @c transmitStatusReceived() signal.
+ *
+ * Parsed frames are published to the user interface through a lock-free queue, the
+ * user interface takes frames from it at its own pace. If the queue is full, frames
+ * are still logged, but they are not displayed. The telemetry history is filled by the
+ * ingestion thread as well, so it keeps every valid frame regardless of the pace of
+ * the user interface (the headless @c history command reads it with
+ * @c readHistory()).
+ *
+ * Log data that could not be written (disk too slow, full or failing) is checked once
+ * per second and reported through the console & the @c errorOccurred() signal.
+ */
+class IngestionWorker : public QObject
+{
+    // clang-format off
+    Q_OBJECT
+    // clang-format on
+
+Q_SIGNALS:
+    void printLn(const QString &line);
+    void errorOccurred(const QString &title, const QString &text);
+    void transmitStatusReceived(const quint8 frameId, const quint8 retries,
+                                const quint8 deliveryStatus);
+
+private:
+    IngestionWorker();
+    IngestionWorker(IngestionWorker &&) = delete;
+    IngestionWorker(const IngestionWorker &) = delete;
+    IngestionWorker &operator=(IngestionWorker &&) = delete;
+    IngestionWorker &operator=(const IngestionWorker &) = delete;
+
+public:
+    static IngestionWorker &instance();
+    static QDir logDirectory(const QDateTime &dateTime);
+
+public:
+    quint64 droppedFrames() const;
+    bool takeFrame(ReceivedFrame &frame);
+
+    /**
+     * Calls @a function with the payload & container telemetry histories, which are
+     * locked during the call. Can be called from any thread.
+     */
+    template<typename Function>
+    void readHistory(Function function) const
+    {
+        QMutexLocker locker(&m_historyMutex);
+        function(m_payloadHistory, m_containerHistory);
+    }
+
+public Q_SLOTS:
+    void start();
+    void stop();
+
+private Q_SLOTS:
+    void finish();
+    void checkLogs();
+    void onDataReceived(const QByteArray &data);
+
+private:
+    void processFrame(QByteArrayView frame);
+    void processApiFrame(QByteArrayView frame);
+    void processReceivePacket(QByteArrayView frame);
+    void processTransmitStatus(QByteArrayView frame);
+    bool createCsv(const bool createContainerCsv);
+    bool createMissionLog(const QDir &dir, const QDateTime &dateTime,
+                          const Misc::LogWriter::Policy &policy);
+
+    template<typename Writer>
+    void reportLogLoss(const Writer &writer, quint64 &reportedBytes);
+    void reportDecoderErrors();
+
+private:
+    QThread m_thread;
+    FrameScanner m_scanner;
+    XBee::ApiMode m_apiMode;
+    XBee::FrameDecoder m_apiDecoder;
+    quint64 m_apiInvalidFrames;
+    quint64 m_apiDiscardedBytes;
+
+    bool m_syncOnStateChange;
+    Misc::LogWriter m_payloadCsv;
+    Misc::LogWriter m_containerCsv;
+    MissionLogWriter m_missionLog;
+    FixedString<16> m_payloadState;
+    FixedString<16> m_containerState;
+    quint64 m_payloadCsvLoss;
+    quint64 m_containerCsvLoss;
+    quint64 m_missionLogLoss;
+
+    mutable QMutex m_historyMutex;
+    TelemetryHistory<PayloadTelemetry> m_payloadHistory;
+    TelemetryHistory<ContainerTelemetry> m_containerHistory;
+
+    std::atomic<quint64> m_droppedFrames;
+    Misc::SpscQueue<ReceivedFrame, 1024> m_queue;
+};
+}
@@ -0,0 +1,200 @@
+/*
+ * Copyright (c) 2022 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "LatencyTracker.h"
+
+#include <QJsonValue>
+#include <QVariantMap>
+
+/*
+ * Commands that are not echoed within this time (in microseconds) are forgotten
+ */
+static constexpr qint64 ECHO_TIMEOUT = 60 * 1000 * 1000;
+
+/*
+ * Converts a latency in microseconds to milliseconds
+ */
+static double toMilliseconds(const qint64 microseconds)
+{
+    return qRound64(microseconds / 100.0) / 10.0;
+}
+
+/*
+ * Returns the statistics of the given @a histograms for the user interface
+ */
+static QVariantList toStatistics(const QMap<QString, Misc::LatencyHistogram> &histograms)
+{
+    QVariantList list;
+    for (auto it = histograms.cbegin(); it != histograms.cend(); ++it)
+    {
+        QVariantMap item;
+        item.insert("type", it.key());
+        item.insert("count", it.value().count());
+        item.insert("p50", toMilliseconds(it.value().percentile(50)));
+        item.insert("p99", toMilliseconds(it.value().percentile(99)));
+        item.insert("max", toMilliseconds(it.value().max()));
+        list.append(item);
+    }
+
+    return list;
+}
+
+/*
+ * Returns the statistics of the given @a histograms for the session summary
+ */
+static QJsonObject toSummary(const QMap<QString, Misc::LatencyHistogram> &histograms)
+{
+    QJsonObject commands;
+    for (auto it = histograms.cbegin(); it != histograms.cend(); ++it)
+    {
+        const auto &histogram = it.value();
+
+        QJsonObject item;
+        item.insert("count", static_cast<qint64>(histogram.count()));
+        item.insert("min", toMilliseconds(histogram.min()));
+        item.insert("mean", toMilliseconds(qRound64(histogram.mean())));
+        item.insert("p50", toMilliseconds(histogram.percentile(50)));
+        item.insert("p90", toMilliseconds(histogram.percentile(90)));
+        item.insert("p99", toMilliseconds(histogram.percentile(99)));
+        item.insert("max", toMilliseconds(histogram.max()));
+        commands.insert(it.key(), item);
+    }
+
+    return commands;
+}
+
+/**
+ * Returns @c true if no latencies have been recorded
+ */
+bool CanSat::LatencyTracker::isEmpty() const
+{
+    return m_histograms.isEmpty() && m_delivery.isEmpty();
+}
+
+/**
+ * Returns the latency statistics of each command type for the user interface. Each
+ * item is a map with the command @c type, the sample @c count and the @c p50, @c p99
+ * & @c max latencies in milliseconds.
+ */
+QVariantList CanSat::LatencyTracker::statistics() const
+{
+    return toStatistics(m_histograms);
+}
+
+/**
+ * Returns the delivery latency statistics of each command type, with the same format
+ * as @c statistics().
+ */
+QVariantList CanSat::LatencyTracker::deliveryStatistics() const
+{
+    return toStatistics(m_delivery);
+}
+
+/**
+ * Returns the round-trip & delivery latency statistics of each command type & the
+ * number of commands that were never echoed, used to write the session summary.
+ */
+QJsonObject CanSat::LatencyTracker::summary() const
+{
+    QJsonObject summary;
+    summary.insert("unit", "ms");
+    summary.insert("commands", toSummary(m_histograms));
+    summary.insert("delivery", toSummary(m_delivery));
+    summary.insert("unmatched", m_pending.count());
+    return summary;
+}
+
+/**
+ * Removes all the recorded latencies & pending commands
+ */
+void CanSat::LatencyTracker::clear()
+{
+    m_pending.clear();
+    m_lastEcho.clear();
+    m_histograms.clear();
+    m_delivery.clear();
+}
+
+/**
+ * Registers a @a command that was sent at the given steady clock @a time
+ * (microseconds) & starts waiting for its echo
+ */
+void CanSat::LatencyTracker::commandSent(const QString &command, const qint64 time)
+{
+    // Forget commands that were never echoed
+    for (auto it = m_pending.begin(); it != m_pending.end();)
+    {
+        if (time - it.value().time > ECHO_TIMEOUT)
+            it = m_pending.erase(it);
+        else
+            ++it;
+    }
+
+    // Get command fields (e.g. CMD,1099,CX,ON;)
+    auto text = command.trimmed();
+    if (text.endsWith(';'))
+        text.chop(1);
+
+    const auto fields = text.split(',');
+    if (fields.count() < 3)
+        return;
+
+    // Echo is made of the command type & arguments without separators. If the same
+    // command is sent again before its echo arrives, the first send is kept, since
+    // the echo cannot tell the copies apart.
+    const auto echo = fields.mid(2).join(QString()).toUtf8();
+    if (!m_pending.contains(echo))
+        m_pending.insert(echo, { fields.at(2), time });
+}
+
+/**
+ * Matches the command @a echo of a container frame received at the given steady
+ * clock @a time (microseconds) with the pending commands, returns @c true if a
+ * latency was recorded.
+ */
+bool CanSat::LatencyTracker::echoReceived(QByteArrayView echo, const qint64 time)
+{
+    // Only check echo changes
+    if (echo.isEmpty() || m_lastEcho == echo)
+        return false;
+
+    m_lastEcho = echo.toByteArray();
+
+    // Find command
+    const auto it = m_pending.find(m_lastEcho);
+    if (it == m_pending.end())
+        return false;
+
+    // Record latency
+    m_histograms[it.value().type].record(time - it.value().time);
+    m_pending.erase(it);
+    return true;
+}
+
+/**
+ * Records the delivery @a latency (microseconds) of a command of the given @a type,
+ * as reported by the transmit status of the radio.
+ */
+void CanSat::LatencyTracker::commandDelivered(const QString &type, const qint64 latency)
+{
+    m_delivery[type].record(latency);
+}
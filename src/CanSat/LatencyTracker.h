@@ -0,0 +1,75 @@
+/*
+ * Copyright (c) 2022 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#pragma once
+
+#include <QMap>
+#include <QHash>
+#include <QString>
+#include <QJsonObject>
+#include <QVariantList>
+
+#include <Misc/LatencyHistogram.h>
+
+namespace CanSat
+{
+/**
+ * @brief The LatencyTracker class
+ *
+ * Measures the round-trip latency of the commands sent to the container. Every
+ * transmitted command is stamped with a steady clock time stamp, and the command echo
+ * field of the decoded container frames is matched against the commands that are
+ * waiting for their echo (e.g. "CMD,1099,CX,ON;" is echoed as "CXON").
+ *
+ * Latencies are recorded in one HDR-style histogram per command type (CX, ST, SIMP...).
+ * The container repeats its last echo in every frame, so echoes are only matched when
+ * they change: consecutive identical commands are measured once.
+ *
+ * The delivery latency reported by the radio (time until the XBee acknowledged the
+ * transmission, including retries) is kept in a separate set of histograms.
+ */
+class LatencyTracker
+{
+public:
+    bool isEmpty() const;
+    QVariantList statistics() const;
+    QVariantList deliveryStatistics() const;
+    QJsonObject summary() const;
+
+    void clear();
+    void commandSent(const QString &command, const qint64 time);
+    bool echoReceived(QByteArrayView echo, const qint64 time);
+    void commandDelivered(const QString &type, const qint64 latency);
+
+private:
+    struct PendingCommand
+    {
+        QString type;
+        qint64 time;
+    };
+
+    QByteArray m_lastEcho;
+    QHash<QByteArray, PendingCommand> m_pending;
+    QMap<QString, Misc::LatencyHistogram> m_histograms;
+    QMap<QString, Misc::LatencyHistogram> m_delivery;
+};
+}
@@ -0,0 +1,675 @@
+/*
+ * Copyright (c) 2022 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "MissionLog.h"
+
+#include <QtEndian>
+#include <QDateTime>
+
+#include <cstring>
+#include <algorithm>
+
+/*
+ * File header: magic (8 bytes), format version (4 bytes), reserved (4 bytes) &
+ * creation time in milliseconds since epoch (8 bytes)
+ */
+static constexpr char FILE_MAGIC[] = "CCMLOG01";
+static constexpr quint32 FILE_VERSION = 1;
+static constexpr qint64 FILE_HEADER_SIZE = 24;
+
+/*
+ * Record header (size, type, reserved bytes & timestamp) and trailer (total size)
+ */
+static constexpr qint64 RECORD_HEADER_SIZE = 16;
+static constexpr qint64 RECORD_TRAILER_SIZE = 4;
+static constexpr qint64 RECORD_OVERHEAD = RECORD_HEADER_SIZE + RECORD_TRAILER_SIZE;
+
+/*
+ * Index block header (previous index offset, entry count & reserved bytes) and size
+ * of each index entry (timestamp & offset)
+ */
+static constexpr qint64 INDEX_HEADER_SIZE = 16;
+static constexpr qint64 INDEX_ENTRY_SIZE = 16;
+
+/*
+ * Number of seconds of received data described by each index block
+ */
+static constexpr int INDEX_INTERVAL = 10;
+
+/*
+ * Records larger than this are considered to be corrupted
+ */
+static constexpr quint32 MAX_RECORD_SIZE = 16 * 1024 * 1024;
+
+/*
+ * Size of the read buffer & maximum number of records that are walked backwards when
+ * looking for the last index block
+ */
+static constexpr qsizetype READ_BUFFER_SIZE = 1024 * 1024;
+static constexpr int MAX_BACKWARD_STEPS = 100000;
+
+//------------------------------------------------------------------------------
+// Writer
+//------------------------------------------------------------------------------
+
+/**
+ * Constructor function
+ */
+CanSat::MissionLogWriter::MissionLogWriter()
+    : m_position(0)
+    , m_lastSecond(-1)
+    , m_lastIndexOffset(-1)
+{
+}
+
+/**
+ * Writes the last index block & closes the log
+ */
+CanSat::MissionLogWriter::~MissionLogWriter()
+{
+    close();
+}
+
+/**
+ * Returns @c true if the log file is open
+ */
+bool CanSat::MissionLogWriter::isOpen() const
+{
+    return m_writer.isOpen();
+}
+
+/**
+ * Returns the path of the log file
+ */
+QString CanSat::MissionLogWriter::fileName() const
+{
+    return m_writer.fileName();
+}
+
+/**
+ * Returns a description of the last error that occurred while opening the file
+ */
+QString CanSat::MissionLogWriter::errorString() const
+{
+    return m_writer.errorString();
+}
+
+/**
+ * Returns the number of bytes that could not be written to the file
+ */
+quint64 CanSat::MissionLogWriter::failedBytes() const
+{
+    return m_writer.failedBytes();
+}
+
+/**
+ * Returns the number of bytes that were discarded because the disk did not keep up
+ */
+quint64 CanSat::MissionLogWriter::droppedBytes() const
+{
+    return m_writer.droppedBytes();
+}
+
+/**
+ * Returns a description of the last error that occurred while writing to the file
+ */
+QString CanSat::MissionLogWriter::writeErrorString() const
+{
+    return m_writer.writeErrorString();
+}
+
+/**
+ * Creates a new mission log at the given @a fileName, using the given flush
+ * @a policy. Returns @c false if the file cannot be created.
+ */
+bool CanSat::MissionLogWriter::open(const QString &fileName,
+                                    const Misc::LogWriter::Policy &policy)
+{
+    close();
+
+    m_writer.setPolicy(policy);
+    if (!m_writer.open(fileName))
+        return false;
+
+    QByteArray header(FILE_HEADER_SIZE, '\0');
+    std::memcpy(header.data(), FILE_MAGIC, 8);
+    qToLittleEndian<quint32>(FILE_VERSION, header.data() + 8);
+    qToLittleEndian<qint64>(QDateTime::currentMSecsSinceEpoch(), header.data() + 16);
+    m_writer.append(header);
+
+    m_entries.clear();
+    m_lastSecond = -1;
+    m_lastIndexOffset = -1;
+    m_position = FILE_HEADER_SIZE;
+    return true;
+}
+
+/**
+ * Writes the index block of the last seconds of data & closes the log
+ */
+void CanSat::MissionLogWriter::close()
+{
+    if (!isOpen())
+        return;
+
+    if (!m_entries.isEmpty())
+        writeIndex(m_entries.last().timestamp);
+
+    m_writer.close();
+}
+
+/**
+ * Writes pending data & commits the log to disk
+ */
+void CanSat::MissionLogWriter::sync()
+{
+    m_writer.sync();
+}
+
+/**
+ * Appends a record with the given @a type, receive @a timestamp & @a data to the log.
+ * An index block is written before the record if it starts a new second & enough
+ * seconds have been logged since the previous index block.
+ *
+ * Timestamps come from the wall clock, which may be set back while logging (e.g. by
+ * NTP or GPS). Only records that start a later second than the last indexed one are
+ * indexed, so that the index stays sorted.
+ */
+void CanSat::MissionLogWriter::append(const MissionLogRecord::Type type,
+                                      const qint64 timestamp, QByteArrayView data)
+{
+    if (!isOpen())
+        return;
+
+    const auto second = timestamp / 1000;
+    if (second > m_lastSecond)
+    {
+        if (m_entries.size() >= INDEX_INTERVAL)
+            writeIndex(timestamp);
+
+        m_entries.append({ timestamp, m_position });
+        m_lastSecond = second;
+    }
+
+    writeRecord(type, timestamp, data);
+}
+
+/**
+ * Writes an index block with the pending index entries
+ */
+void CanSat::MissionLogWriter::writeIndex(const qint64 timestamp)
+{
+    QByteArray block(INDEX_HEADER_SIZE + m_entries.size() * INDEX_ENTRY_SIZE, '\0');
+    auto data = block.data();
+    qToLittleEndian<qint64>(m_lastIndexOffset, data);
+    qToLittleEndian<quint32>(static_cast<quint32>(m_entries.size()), data + 8);
+
+    data += INDEX_HEADER_SIZE;
+    for (const auto &entry : qAsConst(m_entries))
+    {
+        qToLittleEndian<qint64>(entry.timestamp, data);
+        qToLittleEndian<qint64>(entry.offset, data + 8);
+        data += INDEX_ENTRY_SIZE;
+    }
+
+    m_lastIndexOffset = m_position;
+    writeRecord(MissionLogRecord::IndexBlock, timestamp, block);
+    m_entries.clear();
+}
+
+/**
+ * Serializes a record into the scratch buffer & passes it to the log writer
+ */
+void CanSat::MissionLogWriter::writeRecord(const MissionLogRecord::Type type,
+                                           const qint64 timestamp, QByteArrayView data)
+{
+    const auto total = RECORD_OVERHEAD + data.size();
+    m_record.resize(total);
+
+    auto p = m_record.data();
+    qToLittleEndian<quint32>(static_cast<quint32>(data.size()), p);
+    p[4] = static_cast<char>(type);
+    p[5] = p[6] = p[7] = 0;
+    qToLittleEndian<qint64>(timestamp, p + 8);
+    std::memcpy(p + RECORD_HEADER_SIZE, data.data(), data.size());
+    qToLittleEndian<quint32>(static_cast<quint32>(total), p + total - RECORD_TRAILER_SIZE);
+
+    m_writer.append(m_record);
+    m_position += total;
+}
+
+//------------------------------------------------------------------------------
+// Reader
+//------------------------------------------------------------------------------
+
+/**
+ * Constructor function
+ */
+CanSat::MissionLogReader::MissionLogReader()
+    : m_startTime(0)
+    , m_bufferPos(0)
+    , m_bufferOffset(0)
+{
+}
+
+/**
+ * Returns @c true if a log file is open
+ */
+bool CanSat::MissionLogReader::isOpen() const
+{
+    return m_file.isOpen();
+}
+
+/**
+ * Returns the time at which the log was created, in milliseconds since epoch
+ */
+qint64 CanSat::MissionLogReader::startTime() const
+{
+    return m_startTime;
+}
+
+/**
+ * Returns a description of the last error
+ */
+QString CanSat::MissionLogReader::errorString() const
+{
+    return m_error;
+}
+
+/**
+ * Returns the number of seconds of data that can be reached with @c seek()
+ */
+qsizetype CanSat::MissionLogReader::indexedSeconds() const
+{
+    return m_index.size();
+}
+
+/**
+ * Opens the mission log at the given @a fileName, validates its header & loads its
+ * index. Returns @c false if the file cannot be opened or is not a mission log.
+ */
+bool CanSat::MissionLogReader::open(const QString &fileName)
+{
+    close();
+
+    m_file.setFileName(fileName);
+    if (!m_file.open(QFile::ReadOnly))
+    {
+        m_error = m_file.errorString();
+        return false;
+    }
+
+    const auto header = m_file.read(FILE_HEADER_SIZE);
+    if (header.size() != FILE_HEADER_SIZE || !header.startsWith(FILE_MAGIC)
+        || qFromLittleEndian<quint32>(header.constData() + 8) != FILE_VERSION)
+    {
+        m_error = QObject::tr("Invalid mission log file");
+        m_file.close();
+        return false;
+    }
+
+    m_startTime = qFromLittleEndian<qint64>(header.constData() + 16);
+    buildIndex();
+    return rewind();
+}
+
+/**
+ * Closes the log file & releases the read buffer
+ */
+void CanSat::MissionLogReader::close()
+{
+    m_file.close();
+    m_index.clear();
+    m_buffer.clear();
+    m_error.clear();
+    m_startTime = 0;
+    m_bufferPos = 0;
+    m_bufferOffset = 0;
+}
+
+/**
+ * Moves the read position to the first record of the log
+ */
+bool CanSat::MissionLogReader::rewind()
+{
+    return seekOffset(FILE_HEADER_SIZE);
+}
+
+/**
+ * Moves the read position to the first record received during the second that
+ * contains the given @a timestamp, or to the first record of the next logged second.
+ */
+bool CanSat::MissionLogReader::seek(const qint64 timestamp)
+{
+    const auto second = timestamp / 1000;
+    const auto it = std::lower_bound(m_index.cbegin(), m_index.cend(), second,
+                                     [](const IndexEntry &entry, const qint64 s) {
+                                         return entry.timestamp / 1000 < s;
+                                     });
+
+    if (it == m_index.cend())
+        return seekOffset(m_file.size());
+
+    return seekOffset(it->offset);
+}
+
+/**
+ * Moves the read position to the given @a second after the creation of the log
+ */
+bool CanSat::MissionLogReader::seekToMissionSecond(const qint64 second)
+{
+    return seek(m_startTime + second * 1000);
+}
+
+/**
+ * Reads the next frame record of the log, index blocks are skipped. Returns @c false
+ * at the end of the log or if a corrupted (e.g. truncated) record is found.
+ */
+bool CanSat::MissionLogReader::readNext(MissionLogRecord &record)
+{
+    while (readRecord(record))
+    {
+        if (record.type != MissionLogRecord::IndexBlock)
+            return true;
+    }
+
+    return false;
+}
+
+/**
+ * Writes the frames of the given @a type to a CSV file at @a fileName, one frame per
+ * line, exactly as they were received. Returns @c false if the file cannot be
+ * written.
+ */
+bool CanSat::MissionLogReader::exportCsv(const QString &fileName,
+                                         const MissionLogRecord::Type type)
+{
+    QFile file(fileName);
+    if (!isOpen() || !file.open(QFile::WriteOnly))
+    {
+        m_error = file.errorString();
+        return false;
+    }
+
+    rewind();
+
+    bool ok = true;
+    QByteArray batch;
+    MissionLogRecord record;
+    batch.reserve(READ_BUFFER_SIZE);
+    while (ok && readNext(record))
+    {
+        if (record.type != type)
+            continue;
+
+        batch.append(record.data.data(), record.data.size());
+        batch.append('\n');
+        if (batch.size() >= READ_BUFFER_SIZE)
+        {
+            ok = file.write(batch) == batch.size();
+            batch.resize(0);
+        }
+    }
+
+    ok = ok && file.write(batch) == batch.size();
+    if (!ok)
+        m_error = file.errorString();
+
+    return ok;
+}
+
+/**
+ * Loads the index of the log. The last index block is found by walking backwards from
+ * the end of the file; records logged after it are indexed on the way. If the end of
+ * the file is corrupted, all the records of the log are scanned instead.
+ */
+bool CanSat::MissionLogReader::buildIndex()
+{
+    m_index.clear();
+
+    quint32 size;
+    qint64 end = m_file.size();
+    MissionLogRecord record;
+    QVector<IndexEntry> tail;
+    for (int step = 0; step < MAX_BACKWARD_STEPS; ++step)
+    {
+        // Reached the beginning of the log, there are no index blocks
+        if (end == FILE_HEADER_SIZE)
+        {
+            std::reverse(tail.begin(), tail.end());
+            appendIndexEntries(tail);
+            return true;
+        }
+
+        // Read the total size of the previous record from its trailer
+        char trailer[RECORD_TRAILER_SIZE];
+        if (end < FILE_HEADER_SIZE + RECORD_OVERHEAD || !m_file.seek(end - 4)
+            || m_file.read(trailer, RECORD_TRAILER_SIZE) != RECORD_TRAILER_SIZE)
+            break;
+
+        const auto total = qFromLittleEndian<quint32>(trailer);
+        const auto start = end - total;
+        if (total < RECORD_OVERHEAD || start < FILE_HEADER_SIZE
+            || !readRecordHeader(start, record, size) || size + RECORD_OVERHEAD != total)
+            break;
+
+        // Found the last index block, load the rest of the index from it
+        if (record.type == MissionLogRecord::IndexBlock)
+        {
+            if (!readIndexChain(start))
+                break;
+
+            std::reverse(tail.begin(), tail.end());
+            appendIndexEntries(tail);
+            return true;
+        }
+
+        // Index the first record of each second
+        const auto second = record.timestamp / 1000;
+        if (!tail.isEmpty() && tail.last().timestamp / 1000 == second)
+            tail.last() = { record.timestamp, start };
+        else
+            tail.append({ record.timestamp, start });
+
+        end = start;
+    }
+
+    // Corrupted log, scan every record
+    m_index.clear();
+    scanRecords(FILE_HEADER_SIZE);
+    return false;
+}
+
+/**
+ * Loads the entries of the index block at @a offset & of all the index blocks that
+ * precede it
+ */
+bool CanSat::MissionLogReader::readIndexChain(qint64 offset)
+{
+    quint32 size;
+    MissionLogRecord record;
+    QVector<QVector<IndexEntry>> blocks;
+    while (offset >= FILE_HEADER_SIZE)
+    {
+        // Read index block
+        if (!readRecordHeader(offset, record, size)
+            || record.type != MissionLogRecord::IndexBlock || size < INDEX_HEADER_SIZE)
+            return false;
+
+        const auto data = m_file.read(size);
+        if (data.size() != qsizetype(size))
+            return false;
+
+        // Validate entry count
+        const auto count = qFromLittleEndian<quint32>(data.constData() + 8);
+        if (INDEX_HEADER_SIZE + qint64(count) * INDEX_ENTRY_SIZE != size)
+            return false;
+
+        // Read index entries
+        QVector<IndexEntry> entries;
+        entries.reserve(count);
+        auto p = data.constData() + INDEX_HEADER_SIZE;
+        for (quint32 i = 0; i < count; ++i, p += INDEX_ENTRY_SIZE)
+        {
+            entries.append({ qFromLittleEndian<qint64>(p),
+                             qFromLittleEndian<qint64>(p + 8) });
+        }
+
+        // Continue with the previous index block
+        blocks.append(entries);
+        const auto previous = qFromLittleEndian<qint64>(data.constData());
+        if (previous >= offset)
+            return false;
+
+        offset = previous;
+    }
+
+    // Blocks were read from last to first
+    for (auto it = blocks.crbegin(); it != blocks.crend(); ++it)
+        appendIndexEntries(*it);
+
+    return true;
+}
+
+/**
+ * Appends the given index @a entries to the index, skipping the entries that do not
+ * start a later second than the last indexed one (the clock was set back while the
+ * log was written), so that the index stays sorted
+ */
+void CanSat::MissionLogReader::appendIndexEntries(const QVector<IndexEntry> &entries)
+{
+    for (const auto &entry : entries)
+    {
+        if (m_index.isEmpty() || entry.timestamp / 1000 > m_index.last().timestamp / 1000)
+            m_index.append(entry);
+    }
+}
+
+/**
+ * Builds the index by reading every record from the given @a offset until the end of
+ * the log (or until a corrupted record is found)
+ */
+void CanSat::MissionLogReader::scanRecords(qint64 offset)
+{
+    seekOffset(offset);
+
+    qint64 lastSecond = -1;
+    MissionLogRecord record;
+    while (readRecord(record))
+    {
+        if (record.type == MissionLogRecord::IndexBlock)
+            continue;
+
+        const auto second = record.timestamp / 1000;
+        if (second > lastSecond)
+        {
+            m_index.append({ record.timestamp, record.offset });
+            lastSecond = second;
+        }
+    }
+}
+
+/**
+ * Moves the file position to the given @a offset & discards the read buffer
+ */
+bool CanSat::MissionLogReader::seekOffset(const qint64 offset)
+{
+    m_buffer.resize(0);
+    m_bufferPos = 0;
+    m_bufferOffset = offset;
+    return isOpen() && m_file.seek(offset);
+}
+
+/**
+ * Makes sure that at least @a bytes unread bytes are available in the read buffer,
+ * reading large chunks of the file when needed
+ */
+bool CanSat::MissionLogReader::ensure(const qsizetype bytes)
+{
+    if (m_buffer.size() - m_bufferPos >= bytes)
+        return true;
+
+    // Discard consumed data
+    m_buffer.remove(0, m_bufferPos);
+    m_bufferOffset += m_bufferPos;
+    m_bufferPos = 0;
+
+    // Read the next chunk of the file
+    const auto available = m_buffer.size();
+    m_buffer.resize(qMax(bytes, READ_BUFFER_SIZE));
+    const auto read = m_file.read(m_buffer.data() + available,
+                                  m_buffer.size() - available);
+
+    m_buffer.resize(available + qMax<qint64>(0, read));
+    return m_buffer.size() >= bytes;
+}
+
+/**
+ * Reads the record at the current position & moves to the next record
+ */
+bool CanSat::MissionLogReader::readRecord(MissionLogRecord &record)
+{
+    // Read record header
+    if (!ensure(RECORD_HEADER_SIZE))
+        return false;
+
+    auto p = m_buffer.constData() + m_bufferPos;
+    const auto size = qFromLittleEndian<quint32>(p);
+    if (size > MAX_RECORD_SIZE)
+        return false;
+
+    // Read record data & validate trailer
+    const auto total = RECORD_OVERHEAD + size;
+    if (!ensure(total))
+        return false;
+
+    p = m_buffer.constData() + m_bufferPos;
+    if (qFromLittleEndian<quint32>(p + total - RECORD_TRAILER_SIZE) != total)
+        return false;
+
+    record.offset = m_bufferOffset + m_bufferPos;
+    record.type = static_cast<MissionLogRecord::Type>(p[4]);
+    record.timestamp = qFromLittleEndian<qint64>(p + 8);
+    record.data = QByteArrayView(p + RECORD_HEADER_SIZE, size);
+
+    m_bufferPos += total;
+    return true;
+}
+
+/**
+ * Reads the header of the record at the given @a offset directly from the file,
+ * leaving the file position at the start of the record data
+ */
+bool CanSat::MissionLogReader::readRecordHeader(const qint64 offset,
+                                                MissionLogRecord &record, quint32 &size)
+{
+    char header[RECORD_HEADER_SIZE];
+    if (!m_file.seek(offset)
+        || m_file.read(header, RECORD_HEADER_SIZE) != RECORD_HEADER_SIZE)
+        return false;
+
+    size = qFromLittleEndian<quint32>(header);
+    record.offset = offset;
+    record.type = static_cast<MissionLogRecord::Type>(header[4]);
+    record.timestamp = qFromLittleEndian<qint64>(header + 8);
+    return size <= MAX_RECORD_SIZE;
+}
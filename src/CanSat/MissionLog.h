@@ -0,0 +1,182 @@
+/*
+ * Copyright (c) 2022 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#pragma once
+
+#include <QFile>
+#include <QVector>
+#include <QByteArray>
+
+#include <Misc/LogWriter.h>
+
+namespace CanSat
+{
+/**
+ * @brief Record stored in a binary mission log
+ *
+ * Mission logs start with a 24-byte header (the "CCMLOG01" magic, the format version
+ * & the creation time). Each record is stored as:
+ *
+ * - @c quint32 size of the record data
+ * - @c quint8 record type & three reserved bytes
+ * - @c qint64 receive timestamp (milliseconds since epoch)
+ * - record data
+ * - @c quint32 total size of the record, so that the log can be walked backwards
+ *
+ * Every few seconds of received data, an index block is appended. It lists the
+ * offset of the first record of each second since the previous index block, and the
+ * offset of the previous index block. All integers are stored in little-endian order.
+ *
+ * @note @c data is a view into the reader buffer, valid until the next read.
+ */
+struct MissionLogRecord
+{
+    enum Type : quint8
+    {
+        PayloadFrame = 1,
+        ContainerFrame = 2,
+        UnknownFrame = 3,
+        IndexBlock = 0x7F,
+    };
+
+    Type type = UnknownFrame;
+    qint64 offset = 0;
+    qint64 timestamp = 0;
+    QByteArrayView data;
+};
+
+/**
+ * @brief The MissionLogWriter class
+ *
+ * Appends received frames to a binary mission log through a @c Misc::LogWriter, and
+ * periodically writes the sparse index blocks used to seek the log by time.
+ */
+class MissionLogWriter
+{
+public:
+    MissionLogWriter();
+    ~MissionLogWriter();
+
+    MissionLogWriter(MissionLogWriter &&) = delete;
+    MissionLogWriter(const MissionLogWriter &) = delete;
+    MissionLogWriter &operator=(MissionLogWriter &&) = delete;
+    MissionLogWriter &operator=(const MissionLogWriter &) = delete;
+
+    bool isOpen() const;
+    QString fileName() const;
+    QString errorString() const;
+    quint64 failedBytes() const;
+    quint64 droppedBytes() const;
+    QString writeErrorString() const;
+
+    bool open(const QString &fileName, const Misc::LogWriter::Policy &policy);
+    void close();
+    void sync();
+
+    void append(const MissionLogRecord::Type type, const qint64 timestamp,
+                QByteArrayView data);
+
+private:
+    void writeIndex(const qint64 timestamp);
+    void writeRecord(const MissionLogRecord::Type type, const qint64 timestamp,
+                     QByteArrayView data);
+
+private:
+    struct IndexEntry
+    {
+        qint64 timestamp;
+        qint64 offset;
+    };
+
+    qint64 m_position;
+    qint64 m_lastSecond;
+    qint64 m_lastIndexOffset;
+
+    QByteArray m_record;
+    Misc::LogWriter m_writer;
+    QVector<IndexEntry> m_entries;
+};
+
+/**
+ * @brief The MissionLogReader class
+ *
+ * Reads binary mission logs sequentially through a large buffer, allows seeking to
+ * any second of the mission using the index blocks & converts the logged frames back
+ * to CSV files on demand.
+ *
+ * If the log was not closed properly (e.g. the application crashed), the index is
+ * rebuilt by scanning all the complete records of the file.
+ */
+class MissionLogReader
+{
+public:
+    MissionLogReader();
+
+    MissionLogReader(MissionLogReader &&) = delete;
+    MissionLogReader(const MissionLogReader &) = delete;
+    MissionLogReader &operator=(MissionLogReader &&) = delete;
+    MissionLogReader &operator=(const MissionLogReader &) = delete;
+
+    bool isOpen() const;
+    qint64 startTime() const;
+    QString errorString() const;
+    qsizetype indexedSeconds() const;
+
+    bool open(const QString &fileName);
+    void close();
+
+    bool rewind();
+    bool seek(const qint64 timestamp);
+    bool seekToMissionSecond(const qint64 second);
+
+    bool readNext(MissionLogRecord &record);
+    bool exportCsv(const QString &fileName, const MissionLogRecord::Type type);
+
+private:
+    struct IndexEntry
+    {
+        qint64 timestamp;
+        qint64 offset;
+    };
+
+    bool buildIndex();
+    void appendIndexEntries(const QVector<IndexEntry> &entries);
+    bool readIndexChain(qint64 offset);
+    void scanRecords(qint64 offset);
+
+    bool seekOffset(const qint64 offset);
+    bool ensure(const qsizetype bytes);
+    bool readRecord(MissionLogRecord &record);
+    bool readRecordHeader(const qint64 offset, MissionLogRecord &record, quint32 &size);
+
+private:
+    QFile m_file;
+    QString m_error;
+    qint64 m_startTime;
+
+    QByteArray m_buffer;
+    qsizetype m_bufferPos;
+    qint64 m_bufferOffset;
+
+    QVector<IndexEntry> m_index;
+};
+}
@@ -0,0 +1,370 @@
+/*
+ * Copyright (c) 2022 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "SimulationProfile.h"
+
+#include <QDir>
+#include <QFile>
+#include <QtEndian>
+#include <QSaveFile>
+#include <QDateTime>
+#include <QStandardPaths>
+#include <QCryptographicHash>
+
+#include <cstring>
+#include <Misc/NumberParser.h>
+
+/*
+ * Files larger than this are memory-mapped instead of being read into memory
+ */
+static constexpr qint64 MAP_THRESHOLD = 1024 * 1024;
+
+/*
+ * Cache file header: magic, format version, source size, source modification time,
+ * SHA-1 hash of the source, skipped line count & reading count. The readings follow
+ * the header as little-endian 32-bit integers.
+ */
+static constexpr char CACHE_MAGIC[] = "CCSP";
+static constexpr quint32 CACHE_VERSION = 1;
+static constexpr qsizetype HASH_SIZE = 20;
+static constexpr qsizetype CACHE_HEADER_SIZE = 4 + 4 + 8 + 8 + HASH_SIZE + 4 + 4;
+
+/**
+ * Returns the path of the cache file of the profile at the given @a canonicalPath
+ */
+static QString cachePath(const QString &canonicalPath)
+{
+    const auto dir = QStandardPaths::writableLocation(QStandardPaths::AppDataLocation);
+    const auto key = QCryptographicHash::hash(canonicalPath.toUtf8(),
+                                              QCryptographicHash::Sha1);
+    return QString("%1/ProfileCache/%2.bin").arg(dir, QString::fromLatin1(key.toHex()));
+}
+
+/**
+ * Constructor function
+ */
+CanSat::SimulationProfile::SimulationProfile()
+    : m_loadedFromCache(false)
+    , m_skippedLines(0)
+{
+}
+
+/**
+ * Returns @c true if no pressure readings are loaded
+ */
+bool CanSat::SimulationProfile::isEmpty() const
+{
+    return m_pressures.isEmpty();
+}
+
+/**
+ * Returns the number of pressure readings
+ */
+qsizetype CanSat::SimulationProfile::count() const
+{
+    return m_pressures.count();
+}
+
+/**
+ * Returns the path of the loaded profile
+ */
+QString CanSat::SimulationProfile::fileName() const
+{
+    return m_fileName;
+}
+
+/**
+ * Returns a description of the last error that occurred while loading a profile
+ */
+QString CanSat::SimulationProfile::errorString() const
+{
+    return m_errorString;
+}
+
+/**
+ * Returns @c true if the readings were loaded from the profile cache instead of being
+ * parsed from the profile file
+ */
+bool CanSat::SimulationProfile::loadedFromCache() const
+{
+    return m_loadedFromCache;
+}
+
+/**
+ * Returns the number of non-empty lines that did not contain a pressure reading
+ */
+qsizetype CanSat::SimulationProfile::skippedLines() const
+{
+    return m_skippedLines;
+}
+
+/**
+ * Returns the pressure reading at the given @a index
+ */
+quint32 CanSat::SimulationProfile::at(const qsizetype index) const
+{
+    return m_pressures.at(index);
+}
+
+/**
+ * Returns all the pressure readings
+ */
+const QVector<quint32> &CanSat::SimulationProfile::pressures() const
+{
+    return m_pressures;
+}
+
+/**
+ * Unloads the current profile
+ */
+void CanSat::SimulationProfile::clear()
+{
+    m_fileName.clear();
+    m_errorString.clear();
+    m_pressures.clear();
+    m_skippedLines = 0;
+    m_loadedFromCache = false;
+}
+
+/**
+ * Loads the profile at the given @a fileName, returns @c false if the file cannot be
+ * read or if it does not contain any pressure readings.
+ */
+bool CanSat::SimulationProfile::load(const QString &fileName)
+{
+    clear();
+
+    // Open file
+    QFile file(fileName);
+    if (!file.open(QFile::ReadOnly))
+    {
+        m_errorString = file.errorString();
+        return false;
+    }
+
+    // Use cached readings if the file did not change
+    const QFileInfo info(file);
+    if (readCache(info, QByteArray()))
+    {
+        m_fileName = fileName;
+        return true;
+    }
+
+    // Get a memory-mapped view of large files
+    const auto size = file.size();
+    uchar *map = size >= MAP_THRESHOLD ? file.map(0, size) : nullptr;
+
+    // Read small files (or files that cannot be mapped) at once
+    QByteArray buffer;
+    if (!map)
+        buffer = file.readAll();
+
+    // Hash file contents & check if the cache is still valid
+    QByteArrayView data(map ? reinterpret_cast<const char *>(map) : buffer.constData(),
+                        map ? size : buffer.size());
+    const auto hash = QCryptographicHash::hash(data, QCryptographicHash::Sha1);
+    if (readCache(info, hash))
+    {
+        if (map)
+            file.unmap(map);
+
+        writeCache(info, hash);
+        m_fileName = fileName;
+        return true;
+    }
+
+    // Parse file contents
+    parse(data.data(), data.size());
+    if (map)
+        file.unmap(map);
+
+    // Validate profile
+    if (m_pressures.isEmpty())
+    {
+        m_errorString = QObject::tr("The file does not contain pressure readings");
+        return false;
+    }
+
+    // Cache parsed readings
+    writeCache(info, hash);
+    m_fileName = fileName;
+    return true;
+}
+
+/**
+ * Extracts the pressure readings of each line of the given @a data
+ */
+void CanSat::SimulationProfile::parse(const char *data, const qsizetype size)
+{
+    // Estimate number of readings (profile lines are usually shorter than 32 bytes)
+    m_pressures.reserve(size / 32 + 1);
+
+    // Process each line
+    const auto end = data + size;
+    auto line = data;
+    while (line < end)
+    {
+        auto eol = static_cast<const char *>(std::memchr(line, '\n', end - line));
+        if (!eol)
+            eol = end;
+
+        quint32 pressure;
+        if (parseLine(line, eol, pressure))
+            m_pressures.append(pressure);
+
+        line = eol + 1;
+    }
+
+    m_pressures.squeeze();
+}
+
+/**
+ * Obtains the pressure reading from the line between @a begin & @a end, returns
+ * @c false (and counts the line as skipped if it is not empty or a comment) if the
+ * line does not contain a reading.
+ */
+bool CanSat::SimulationProfile::parseLine(const char *begin, const char *end,
+                                          quint32 &pressure)
+{
+    // Trim whitespace
+    while (begin < end && (*begin == ' ' || *begin == '\t'))
+        ++begin;
+    while (end > begin && (end[-1] == ' ' || end[-1] == '\t' || end[-1] == '\r'))
+        --end;
+
+    // Skip empty lines & comments
+    if (begin == end || *begin == '#')
+        return false;
+
+    // Get the last field of the line
+    auto field = end;
+    while (field > begin && field[-1] != ',')
+        --field;
+    while (field < end && (*field == ' ' || *field == '\t'))
+        ++field;
+
+    // Line ends with a separator
+    if (field == end)
+    {
+        ++m_skippedLines;
+        return false;
+    }
+
+    // Parse the reading as an integer
+    if (Misc::NumberParser::parseInteger(field, end, pressure) == end)
+        return true;
+
+    // Parse the reading as a decimal number
+    double value;
+    if (Misc::NumberParser::parseDecimal(field, end, value) == end && value >= 0
+        && value <= 4294967295.0)
+    {
+        pressure = static_cast<quint32>(value + 0.5);
+        return true;
+    }
+
+    // Line does not contain a reading
+    ++m_skippedLines;
+    return false;
+}
+
+/**
+ * Loads the readings of the profile described by @a info from its cache file. If
+ * @a hash is empty, the cache is only valid if the size & modification time of the
+ * profile match, otherwise the size & content @a hash must match.
+ */
+bool CanSat::SimulationProfile::readCache(const QFileInfo &info, const QByteArray &hash)
+{
+    // Open cache file
+    QFile file(cachePath(info.canonicalFilePath()));
+    if (!file.open(QFile::ReadOnly))
+        return false;
+
+    // Read & validate header
+    const auto header = file.read(CACHE_HEADER_SIZE);
+    if (header.size() != CACHE_HEADER_SIZE || !header.startsWith(CACHE_MAGIC))
+        return false;
+
+    auto p = header.constData() + 4;
+    const auto version = qFromLittleEndian<quint32>(p);
+    const auto size = qFromLittleEndian<qint64>(p + 4);
+    const auto modified = qFromLittleEndian<qint64>(p + 12);
+    const auto fileHash = QByteArrayView(p + 20, HASH_SIZE);
+    const auto skipped = qFromLittleEndian<quint32>(p + 20 + HASH_SIZE);
+    const auto count = qFromLittleEndian<quint32>(p + 24 + HASH_SIZE);
+    if (version != CACHE_VERSION || size != info.size() || count == 0)
+        return false;
+
+    // Validate modification time or content hash
+    if (hash.isEmpty())
+    {
+        if (modified != info.lastModified().toMSecsSinceEpoch())
+            return false;
+    }
+
+    else if (fileHash != hash)
+        return false;
+
+    // Read readings
+    const auto values = file.read(qint64(count) * sizeof(quint32));
+    if (values.size() != qsizetype(count * sizeof(quint32)))
+        return false;
+
+    m_pressures.resize(count);
+    qFromLittleEndian<quint32>(values.constData(), count, m_pressures.data());
+    m_skippedLines = skipped;
+    m_loadedFromCache = true;
+    return true;
+}
+
+/**
+ * Writes the current readings to the cache file of the profile described by @a info,
+ * along with its size, modification time & content @a hash
+ */
+void CanSat::SimulationProfile::writeCache(const QFileInfo &info,
+                                           const QByteArray &hash) const
+{
+    // Create cache directory
+    const auto path = cachePath(info.canonicalFilePath());
+    QDir().mkpath(QFileInfo(path).absolutePath());
+
+    // Build header
+    QByteArray data(CACHE_HEADER_SIZE + m_pressures.count() * sizeof(quint32), '\0');
+    auto p = data.data();
+    std::memcpy(p, CACHE_MAGIC, 4);
+    qToLittleEndian<quint32>(CACHE_VERSION, p + 4);
+    qToLittleEndian<qint64>(info.size(), p + 8);
+    qToLittleEndian<qint64>(info.lastModified().toMSecsSinceEpoch(), p + 16);
+    std::memcpy(p + 24, hash.constData(), qMin<qsizetype>(HASH_SIZE, hash.size()));
+    qToLittleEndian<quint32>(static_cast<quint32>(m_skippedLines), p + 24 + HASH_SIZE);
+    qToLittleEndian<quint32>(static_cast<quint32>(m_pressures.count()), p + 28 + HASH_SIZE);
+
+    // Add readings
+    qToLittleEndian<quint32>(m_pressures.constData(), m_pressures.count(),
+                             p + CACHE_HEADER_SIZE);
+
+    // Write cache file, it only replaces the previous one once it is complete, so
+    // that a crash or a full disk never leaves a torn cache behind
+    QSaveFile file(path);
+    if (file.open(QFile::WriteOnly) && file.write(data) == data.size())
+        file.commit();
+}
@@ -0,0 +1,78 @@
+/*
+ * Copyright (c) 2022 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#pragma once
+
+#include <QString>
+#include <QVector>
+#include <QFileInfo>
+
+namespace CanSat
+{
+/**
+ * @brief The SimulationProfile class
+ *
+ * Loads the simulated pressure readings (in pascals) that are sent to the container
+ * with SIMP commands. Profiles are text files with one reading per line, either as a
+ * single value or as a complete command (e.g. "CMD,$,SIMP,101325"), in which case the
+ * last field is used. Empty lines, comments (lines that start with #) and lines that
+ * do not end with a number (e.g. column headers) are skipped.
+ *
+ * The file is parsed in a single pass, directly from a memory-mapped view of the file
+ * when it is large, and readings are stored as a compact array of 32-bit integers.
+ *
+ * Parsed profiles are cached as binary files in the application data directory. A
+ * cached profile is used directly if the size & modification time of the source file
+ * did not change; if only the modification time changed, the content hash of the file
+ * decides whether the cache is still valid. Stale caches are replaced automatically.
+ */
+class SimulationProfile
+{
+public:
+    SimulationProfile();
+
+    bool isEmpty() const;
+    qsizetype count() const;
+    QString fileName() const;
+    QString errorString() const;
+    bool loadedFromCache() const;
+    qsizetype skippedLines() const;
+    quint32 at(const qsizetype index) const;
+    const QVector<quint32> &pressures() const;
+
+    void clear();
+    bool load(const QString &fileName);
+
+private:
+    void parse(const char *data, const qsizetype size);
+    bool readCache(const QFileInfo &info, const QByteArray &hash);
+    void writeCache(const QFileInfo &info, const QByteArray &hash) const;
+    bool parseLine(const char *begin, const char *end, quint32 &pressure);
+
+private:
+    QString m_fileName;
+    QString m_errorString;
+    bool m_loadedFromCache;
+    qsizetype m_skippedLines;
+    QVector<quint32> m_pressures;
+};
+}
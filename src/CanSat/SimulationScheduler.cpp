@@ -0,0 +1,196 @@
+/*
+ * Copyright (c) 2022 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "SimulationScheduler.h"
+
+#include <QSettings>
+
+#include <Misc/SteadyClock.h>
+
+/*
+ * Maximum number of missed ticks that are emitted at once with the catch-up policy
+ */
+static constexpr quint64 MAX_CATCH_UP_TICKS = 5;
+
+/*
+ * Timer events that arrive earlier than this (in microseconds) before the deadline
+ * re-arm the timer instead of emitting the tick
+ */
+static constexpr qint64 EARLY_TOLERANCE = 500;
+
+/**
+ * Constructor function
+ */
+CanSat::SimulationScheduler::SimulationScheduler(QObject *parent)
+    : QObject(parent)
+    , m_timer(this)
+    , m_running(false)
+    , m_origin(0)
+    , m_period(1000 * 1000)
+    , m_index(0)
+    , m_ticks(0)
+    , m_skipped(0)
+    , m_policy(Skip)
+{
+    m_timer.setSingleShot(true);
+    m_timer.setTimerType(Qt::PreciseTimer);
+    connect(&m_timer, &QTimer::timeout, this, &SimulationScheduler::onTimeout);
+    loadSettings();
+}
+
+/**
+ * Returns @c true if the scheduler is emitting ticks (or waiting for the pre-roll)
+ */
+bool CanSat::SimulationScheduler::isRunning() const
+{
+    return m_running;
+}
+
+/**
+ * Returns the number of ticks per second
+ */
+double CanSat::SimulationScheduler::rate() const
+{
+    return 1e6 / m_period;
+}
+
+/**
+ * Returns the number of ticks emitted since the scheduler was started
+ */
+quint64 CanSat::SimulationScheduler::ticks() const
+{
+    return m_ticks;
+}
+
+/**
+ * Returns the number of ticks that were dropped because they were missed
+ */
+quint64 CanSat::SimulationScheduler::skippedTicks() const
+{
+    return m_skipped;
+}
+
+/**
+ * Returns the policy applied to missed ticks
+ */
+CanSat::SimulationScheduler::CatchUpPolicy
+CanSat::SimulationScheduler::catchUpPolicy() const
+{
+    return m_policy;
+}
+
+/**
+ * Returns the histogram of the tick lateness (in microseconds)
+ */
+const Misc::LatencyHistogram &CanSat::SimulationScheduler::jitter() const
+{
+    return m_jitter;
+}
+
+/**
+ * Stops emitting ticks
+ */
+void CanSat::SimulationScheduler::stop()
+{
+    m_running = false;
+    m_timer.stop();
+}
+
+/**
+ * Reads the tick rate & the catch-up policy from the application settings, changes
+ * are applied the next time that the scheduler is started
+ */
+void CanSat::SimulationScheduler::loadSettings()
+{
+    QSettings settings;
+    const auto rate = settings.value("Simulation/RateHz", 1.0).toDouble();
+    const auto policy = settings.value("Simulation/CatchUpPolicy", "Skip").toString();
+
+    m_period = static_cast<qint64>(1e6 / qBound(0.01, rate, 1000.0));
+    m_policy = policy.compare("CatchUp", Qt::CaseInsensitive) == 0 ? CatchUp : Skip;
+}
+
+/**
+ * Starts emitting ticks, the first tick is emitted after @a preRoll milliseconds
+ */
+void CanSat::SimulationScheduler::start(const int preRoll)
+{
+    loadSettings();
+
+    m_running = true;
+    m_index = 0;
+    m_ticks = 0;
+    m_skipped = 0;
+    m_jitter.clear();
+
+    const auto now = Misc::SteadyClock::microseconds();
+    m_origin = now + qMax(0, preRoll) * qint64(1000);
+    arm(now);
+}
+
+/**
+ * Emits the ticks whose deadline has passed & re-arms the timer for the next deadline
+ */
+void CanSat::SimulationScheduler::onTimeout()
+{
+    // Timer fired too early, wait until the deadline
+    const auto now = Misc::SteadyClock::microseconds();
+    const auto deadline = m_origin + static_cast<qint64>(m_index) * m_period;
+    if (deadline - now > EARLY_TOLERANCE)
+    {
+        arm(now);
+        return;
+    }
+
+    // Record lateness & get number of elapsed deadlines
+    m_jitter.record(now - deadline);
+    const auto reached = qMax<qint64>(m_index, (now - m_origin) / m_period);
+    const auto due = static_cast<quint64>(reached) - m_index + 1;
+
+    // Emit missed ticks according to the catch-up policy
+    const auto emitted = m_policy == CatchUp ? qMin(due, MAX_CATCH_UP_TICKS) : 1;
+    const auto first = m_index + due - emitted;
+    m_skipped += due - emitted;
+    m_index += due;
+    for (quint64 i = 0; i < emitted; ++i)
+    {
+        ++m_ticks;
+        Q_EMIT tick(first + i);
+
+        // A tick handler stopped the scheduler
+        if (!m_running)
+            return;
+    }
+
+    // Wait for the next deadline
+    arm(Misc::SteadyClock::microseconds());
+}
+
+/**
+ * Starts the timer so that it expires at the next tick deadline
+ */
+void CanSat::SimulationScheduler::arm(const qint64 now)
+{
+    const auto deadline = m_origin + static_cast<qint64>(m_index) * m_period;
+    const auto delay = (deadline - now + 999) / 1000;
+    m_timer.start(static_cast<int>(qMax<qint64>(0, delay)));
+}
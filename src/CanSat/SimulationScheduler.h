@@ -0,0 +1,99 @@
+/*
+ * Copyright (c) 2022 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#pragma once
+
+#include <QTimer>
+#include <QObject>
+
+#include <Misc/LatencyHistogram.h>
+
+namespace CanSat
+{
+/**
+ * @brief The SimulationScheduler class
+ *
+ * Paces the simulated pressure (SIMP) commands. Tick deadlines are absolute steady
+ * clock times (start time + pre-roll + n periods), and the timer is re-armed for the
+ * next deadline after each tick, so the time spent processing a tick never delays the
+ * following ones and the cadence does not drift over long simulations.
+ *
+ * The rate is read from the @c Simulation/RateHz setting (1 Hz by default, faster
+ * rates are useful for bench tests). If the event loop is blocked for longer than a
+ * period, the @c Simulation/CatchUpPolicy setting decides what happens with the missed
+ * ticks: @c Skip (default) emits a single tick and drops the rest, @c CatchUp emits
+ * the missed ticks right away (up to a small burst limit).
+ *
+ * Each tick carries the index of its deadline (counted from the start), so that
+ * receivers can stay in step with the wall clock regardless of dropped ticks.
+ *
+ * The lateness of each tick with respect to its deadline is recorded to report the
+ * jitter of the scheduler.
+ */
+class SimulationScheduler : public QObject
+{
+    // clang-format off
+    Q_OBJECT
+    // clang-format on
+
+Q_SIGNALS:
+    void tick(const quint64 index);
+
+public:
+    enum CatchUpPolicy
+    {
+        Skip,
+        CatchUp,
+    };
+
+    explicit SimulationScheduler(QObject *parent = nullptr);
+
+    bool isRunning() const;
+    double rate() const;
+    quint64 ticks() const;
+    quint64 skippedTicks() const;
+    CatchUpPolicy catchUpPolicy() const;
+    const Misc::LatencyHistogram &jitter() const;
+
+public Q_SLOTS:
+    void stop();
+    void loadSettings();
+    void start(const int preRoll);
+
+private Q_SLOTS:
+    void onTimeout();
+
+private:
+    void arm(const qint64 now);
+
+private:
+    QTimer m_timer;
+    bool m_running;
+    qint64 m_origin;
+    qint64 m_period;
+    quint64 m_index;
+    quint64 m_ticks;
+    quint64 m_skipped;
+    CatchUpPolicy m_policy;
+    Misc::LatencyHistogram m_jitter;
+};
+}
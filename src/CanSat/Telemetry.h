@@ -0,0 +1,237 @@
+/*
+ * Copyright (c) 2022 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#pragma once
+
+#include <QtGlobal>
+#include <QByteArrayView>
+
+#include <tuple>
+#include <cstring>
+#include <string_view>
+
+namespace CanSat
+{
+/**
+ * @brief Fixed-capacity text field, stored inline in telemetry structures
+ */
+template<std::size_t N>
+struct FixedString
+{
+    static_assert(N <= 255, "FixedString capacity must fit in 8 bits");
+
+    char data[N] = {};
+    quint8 size = 0;
+
+    QByteArrayView view() const { return QByteArrayView(data, size); }
+    bool operator==(const FixedString &other) const { return view() == other.view(); }
+    bool operator!=(const FixedString &other) const { return !(*this == other); }
+
+    bool assign(QByteArrayView text)
+    {
+        if (text.size() > qsizetype(N))
+            return false;
+
+        std::memcpy(data, text.data(), text.size());
+        size = static_cast<quint8>(text.size());
+        return true;
+    }
+};
+
+/**
+ * @brief Time of day in the hh:mm:ss[.ss] format, stored in milliseconds
+ */
+struct MissionClock
+{
+    qint32 msecs = -1;
+    bool isValid() const { return msecs >= 0; }
+};
+
+/**
+ * @brief Decoded telemetry frame sent by the container (team ID 1099)
+ */
+struct ContainerTelemetry
+{
+    quint16 teamId = 0;
+    MissionClock missionTime;
+    quint32 packetCount = 0;
+    char mode = 0;
+    FixedString<16> state;
+    float altitude = 0;
+    char hsDeployed = 0;
+    char pcDeployed = 0;
+    char mastRaised = 0;
+    float temperature = 0;
+    float pressure = 0;
+    float voltage = 0;
+    MissionClock gpsTime;
+    float gpsAltitude = 0;
+    double gpsLatitude = 0;
+    double gpsLongitude = 0;
+    quint8 gpsSats = 0;
+    float tiltX = 0;
+    float tiltY = 0;
+    FixedString<32> cmdEcho;
+};
+
+/**
+ * @brief Decoded telemetry frame sent by the payload (team ID 6026)
+ */
+struct PayloadTelemetry
+{
+    quint16 teamId = 0;
+    MissionClock missionTime;
+    quint32 packetCount = 0;
+    char packetType = 0;
+    float altitude = 0;
+    float temperature = 0;
+    float voltage = 0;
+    float gyroR = 0;
+    float gyroP = 0;
+    float gyroY = 0;
+    float accelR = 0;
+    float accelP = 0;
+    float accelY = 0;
+    float magR = 0;
+    float magP = 0;
+    float magY = 0;
+    float pointingError = 0;
+    FixedString<16> state;
+};
+
+/**
+ * @brief Associates a telemetry field name with its member in a telemetry structure
+ */
+template<typename Frame, typename T>
+struct Field
+{
+    using Type = T;
+    const char *name;
+    T Frame::*member;
+};
+
+template<typename Frame, typename T>
+constexpr Field<Frame, T> field(const char *name, T Frame::*member)
+{
+    return Field<Frame, T> { name, member };
+}
+
+/**
+ * @brief Compile-time description of a telemetry frame
+ *
+ * Each specialization defines the prefix (team ID) that identifies the frame & the
+ * ordered list of comma-separated fields that it contains.
+ */
+template<typename Frame>
+struct Schema;
+
+template<>
+struct Schema<ContainerTelemetry>
+{
+    using F = ContainerTelemetry;
+    static constexpr QByteArrayView prefix = "1099";
+
+    // clang-format off
+    static constexpr auto fields = std::make_tuple(
+        field("TEAM_ID",       &F::teamId),
+        field("MISSION_TIME",  &F::missionTime),
+        field("PACKET_COUNT",  &F::packetCount),
+        field("MODE",          &F::mode),
+        field("STATE",         &F::state),
+        field("ALTITUDE",      &F::altitude),
+        field("HS_DEPLOYED",   &F::hsDeployed),
+        field("PC_DEPLOYED",   &F::pcDeployed),
+        field("MAST_RAISED",   &F::mastRaised),
+        field("TEMPERATURE",   &F::temperature),
+        field("PRESSURE",      &F::pressure),
+        field("VOLTAGE",       &F::voltage),
+        field("GPS_TIME",      &F::gpsTime),
+        field("GPS_ALTITUDE",  &F::gpsAltitude),
+        field("GPS_LATITUDE",  &F::gpsLatitude),
+        field("GPS_LONGITUDE", &F::gpsLongitude),
+        field("GPS_SATS",      &F::gpsSats),
+        field("TILT_X",        &F::tiltX),
+        field("TILT_Y",        &F::tiltY),
+        field("CMD_ECHO",      &F::cmdEcho)
+    );
+    // clang-format on
+};
+
+template<>
+struct Schema<PayloadTelemetry>
+{
+    using F = PayloadTelemetry;
+    static constexpr QByteArrayView prefix = "6026";
+
+    // clang-format off
+    static constexpr auto fields = std::make_tuple(
+        field("TEAM_ID",        &F::teamId),
+        field("MISSION_TIME",   &F::missionTime),
+        field("PACKET_COUNT",   &F::packetCount),
+        field("PACKET_TYPE",    &F::packetType),
+        field("ALTITUDE",       &F::altitude),
+        field("TEMPERATURE",    &F::temperature),
+        field("VOLTAGE",        &F::voltage),
+        field("GYRO_R",         &F::gyroR),
+        field("GYRO_P",         &F::gyroP),
+        field("GYRO_Y",         &F::gyroY),
+        field("ACCEL_R",        &F::accelR),
+        field("ACCEL_P",        &F::accelP),
+        field("ACCEL_Y",        &F::accelY),
+        field("MAG_R",          &F::magR),
+        field("MAG_P",          &F::magP),
+        field("MAG_Y",          &F::magY),
+        field("POINTING_ERROR", &F::pointingError),
+        field("STATE",          &F::state)
+    );
+    // clang-format on
+};
+
+/**
+ * Number of fields of the given telemetry frame type
+ */
+template<typename Frame>
+constexpr std::size_t fieldCount()
+{
+    return std::tuple_size_v<std::decay_t<decltype(Schema<Frame>::fields)>>;
+}
+
+/**
+ * Position of the field with the given @a name in the schema of the given telemetry
+ * frame type, or @c fieldCount() if the frame has no such field
+ */
+template<typename Frame>
+constexpr std::size_t fieldIndex(std::string_view name)
+{
+    std::size_t index = 0;
+    std::size_t result = fieldCount<Frame>();
+
+    // clang-format off
+    std::apply([&](const auto &...field) {
+        ((result = (result == fieldCount<Frame>() && name == field.name) ? index : result,
+          ++index), ...);
+    }, Schema<Frame>::fields);
+    // clang-format on
+
+    return result;
+}
+}
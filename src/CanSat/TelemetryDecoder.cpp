@@ -0,0 +1,161 @@
+/*
+ * Copyright (c) 2022 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "TelemetryDecoder.h"
+
+#include <Misc/NumberParser.h>
+
+#include <type_traits>
+
+/**
+ * Returns @c true if the given number parsing function consumed the whole @a text
+ */
+template<typename T>
+static bool parseNumber(QByteArrayView text, T &value)
+{
+    const auto first = text.data();
+    const auto last = text.data() + text.size();
+
+    T result {};
+    const char *end;
+    if constexpr (std::is_floating_point_v<T>)
+        end = Misc::NumberParser::parseDecimal(first, last, result);
+    else
+        end = Misc::NumberParser::parseInteger(first, last, result);
+
+    if (text.isEmpty() || end != last)
+        return false;
+
+    value = result;
+    return true;
+}
+
+/**
+ * Reads a single character field (e.g. flight mode or deployment flags)
+ */
+bool CanSat::TelemetryDecoder::parse(QByteArrayView text, char &value)
+{
+    if (text.size() != 1)
+        return false;
+
+    value = text.front();
+    return true;
+}
+
+/**
+ * Reads a decimal number field with single precision
+ */
+bool CanSat::TelemetryDecoder::parse(QByteArrayView text, float &value)
+{
+    return parseNumber(text, value);
+}
+
+/**
+ * Reads a decimal number field with double precision (e.g. GPS coordinates)
+ */
+bool CanSat::TelemetryDecoder::parse(QByteArrayView text, double &value)
+{
+    return parseNumber(text, value);
+}
+
+/**
+ * Reads a small unsigned integer field
+ */
+bool CanSat::TelemetryDecoder::parse(QByteArrayView text, quint8 &value)
+{
+    return parseNumber(text, value);
+}
+
+/**
+ * Reads an unsigned integer field (e.g. team ID)
+ */
+bool CanSat::TelemetryDecoder::parse(QByteArrayView text, quint16 &value)
+{
+    return parseNumber(text, value);
+}
+
+/**
+ * Reads an unsigned integer field (e.g. packet count)
+ */
+bool CanSat::TelemetryDecoder::parse(QByteArrayView text, quint32 &value)
+{
+    return parseNumber(text, value);
+}
+
+/**
+ * Reads a time field in the hh:mm:ss or hh:mm:ss.ss format
+ */
+bool CanSat::TelemetryDecoder::parse(QByteArrayView text, MissionClock &value)
+{
+    int hours = 0;
+    int minutes = 0;
+    double seconds = 0;
+
+    const auto last = text.data() + text.size();
+    auto p = Misc::NumberParser::parseInteger(text.data(), last, hours);
+    if (p == text.data() || p == last || *p != ':')
+        return false;
+
+    auto begin = p + 1;
+    p = Misc::NumberParser::parseInteger(begin, last, minutes);
+    if (p == begin || p == last || *p != ':')
+        return false;
+
+    begin = p + 1;
+    p = Misc::NumberParser::parseDecimal(begin, last, seconds);
+    if (p == begin || p != last)
+        return false;
+
+    if (hours < 0 || hours > 23 || minutes < 0 || minutes > 59 || seconds < 0
+        || seconds >= 61)
+        return false;
+
+    value.msecs = (hours * 3600 + minutes * 60) * 1000 + qRound(seconds * 1000);
+    return true;
+}
+
+/**
+ * Obtains the next comma-separated field of a frame, without leading & trailing
+ * spaces. @a cursor is set to @c nullptr once the last field has been read.
+ */
+bool CanSat::TelemetryDecoder::nextField(const char *&cursor, const char *end,
+                                         QByteArrayView &field)
+{
+    // No fields left
+    if (!cursor)
+        return false;
+
+    // Find field separator
+    auto begin = cursor;
+    auto comma = static_cast<const char *>(std::memchr(begin, ',', end - begin));
+    auto last = comma ? comma : end;
+    cursor = comma ? comma + 1 : nullptr;
+
+    // Trim spaces
+    while (begin < last && (*begin == ' ' || *begin == '\r' || *begin == '\n'))
+        ++begin;
+    while (last > begin && (last[-1] == ' ' || last[-1] == '\r' || last[-1] == '\n'))
+        --last;
+
+    field = QByteArrayView(begin, last - begin);
+    return true;
+}
@@ -0,0 +1,87 @@
+/*
+ * Copyright (c) 2022 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#pragma once
+
+#include <CanSat/Telemetry.h>
+
+namespace CanSat
+{
+/**
+ * @brief The TelemetryDecoder class
+ *
+ * Converts the comma-separated telemetry frames received from the CanSat into their
+ * typed representation. Fields are split in a single pass & parsed in place, guided by
+ * the compile-time field list of each frame @c Schema, so decoding a frame does not
+ * allocate any memory.
+ */
+class TelemetryDecoder
+{
+public:
+    template<typename Frame>
+    static bool decode(QByteArrayView frame, Frame &telemetry);
+
+public:
+    static bool parse(QByteArrayView text, char &value);
+    static bool parse(QByteArrayView text, float &value);
+    static bool parse(QByteArrayView text, double &value);
+    static bool parse(QByteArrayView text, quint8 &value);
+    static bool parse(QByteArrayView text, quint16 &value);
+    static bool parse(QByteArrayView text, quint32 &value);
+    static bool parse(QByteArrayView text, MissionClock &value);
+
+    template<std::size_t N>
+    static bool parse(QByteArrayView text, FixedString<N> &value)
+    {
+        return value.assign(text);
+    }
+
+private:
+    static bool nextField(const char *&cursor, const char *end, QByteArrayView &field);
+};
+
+/**
+ * Decodes all the fields of the given @a frame into @a telemetry.
+ *
+ * Returns @c false if the frame contains less or more fields than the frame schema,
+ * or if any of the fields cannot be parsed. In that case, @a telemetry may be
+ * partially updated.
+ */
+template<typename Frame>
+bool TelemetryDecoder::decode(QByteArrayView frame, Frame &telemetry)
+{
+    QByteArrayView text;
+    bool ok = !frame.isEmpty();
+    const char *cursor = frame.data();
+    const char *end = frame.data() + frame.size();
+
+    // clang-format off
+    std::apply([&](const auto &...field) {
+        ((ok = ok && nextField(cursor, end, text)
+                  && parse(text, telemetry.*(field.member))), ...);
+    }, Schema<Frame>::fields);
+    // clang-format on
+
+    // All fields must be consumed
+    return ok && cursor == nullptr;
+}
+}
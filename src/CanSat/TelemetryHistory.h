@@ -0,0 +1,196 @@
+/*
+ * Copyright (c) 2022 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#pragma once
+
+#include <memory>
+#include <utility>
+#include <algorithm>
+
+#include <CanSat/Telemetry.h>
+
+namespace CanSat
+{
+/**
+ * @brief Read-only view of a history column, ordered from oldest to newest value
+ *
+ * Because the history is a ring buffer, the values of a column are stored in (at
+ * most) two contiguous segments. Consumers that process large amounts of data should
+ * iterate over @c first & @c second directly.
+ */
+template<typename T>
+struct ColumnView
+{
+    const T *first = nullptr;
+    std::size_t firstSize = 0;
+    const T *second = nullptr;
+    std::size_t secondSize = 0;
+
+    std::size_t size() const { return firstSize + secondSize; }
+    const T &operator[](std::size_t i) const
+    {
+        return i < firstSize ? first[i] : second[i - firstSize];
+    }
+};
+
+/**
+ * @brief The TelemetryHistory class
+ *
+ * Keeps the most recent telemetry frames of a given type in memory, stored column by
+ * column (one contiguous array for each field of the frame @c Schema, plus one for the
+ * receive timestamps).
+ *
+ * The number of frames that can be stored is derived from a fixed memory budget when
+ * the history is created. Once the history is full, new frames overwrite the oldest
+ * ones, so appending is always O(1) & memory usage never grows.
+ */
+template<typename Frame>
+class TelemetryHistory
+{
+    using Fields = std::decay_t<decltype(Schema<Frame>::fields)>;
+    static constexpr auto FIELD_COUNT = fieldCount<Frame>();
+
+    template<typename Tuple>
+    struct Storage;
+
+    template<typename... F>
+    struct Storage<std::tuple<F...>>
+    {
+        using Columns = std::tuple<std::unique_ptr<typename F::Type[]>...>;
+        static constexpr std::size_t ROW_SIZE = (sizeof(typename F::Type) + ...);
+    };
+
+    using Columns = typename Storage<Fields>::Columns;
+
+public:
+    /**
+     * Type of the values stored in the column of the field at position @a I
+     */
+    template<std::size_t I>
+    using ColumnType = typename std::tuple_element_t<I, Fields>::Type;
+
+    /**
+     * Number of bytes used to store one frame
+     */
+    static constexpr std::size_t ROW_SIZE = Storage<Fields>::ROW_SIZE + sizeof(qint64);
+
+    /**
+     * Allocates enough columns to store as many frames as fit in @a memoryBudget bytes
+     */
+    explicit TelemetryHistory(const std::size_t memoryBudget)
+        : m_head(0)
+        , m_size(0)
+        , m_capacity(std::max<std::size_t>(1, memoryBudget / ROW_SIZE))
+        , m_timestamps(new qint64[m_capacity]())
+    {
+        allocate(std::make_index_sequence<FIELD_COUNT>());
+    }
+
+    TelemetryHistory(TelemetryHistory &&) = delete;
+    TelemetryHistory(const TelemetryHistory &) = delete;
+    TelemetryHistory &operator=(TelemetryHistory &&) = delete;
+    TelemetryHistory &operator=(const TelemetryHistory &) = delete;
+
+    std::size_t size() const { return m_size; }
+    bool isEmpty() const { return m_size == 0; }
+    std::size_t capacity() const { return m_capacity; }
+
+    /**
+     * Removes all frames from the history, memory is not released
+     */
+    void clear()
+    {
+        m_head = 0;
+        m_size = 0;
+    }
+
+    /**
+     * Stores the given telemetry @a frame, received at the given @a timestamp. If the
+     * history is full, the oldest frame is discarded.
+     */
+    void append(const qint64 timestamp, const Frame &frame)
+    {
+        m_timestamps[m_head] = timestamp;
+        store(m_head, frame, std::make_index_sequence<FIELD_COUNT>());
+
+        m_head = (m_head + 1 == m_capacity) ? 0 : m_head + 1;
+        m_size = std::min(m_size + 1, m_capacity);
+    }
+
+    /**
+     * Returns the receive timestamps of the stored frames
+     */
+    ColumnView<qint64> timestamps() const { return view(m_timestamps.get()); }
+
+    /**
+     * Returns the values of the field at position @a I of the frame schema
+     */
+    template<std::size_t I>
+    ColumnView<ColumnType<I>> column() const
+    {
+        return view(std::get<I>(m_columns).get());
+    }
+
+private:
+    template<std::size_t... I>
+    void allocate(std::index_sequence<I...>)
+    {
+        ((std::get<I>(m_columns).reset(new ColumnType<I>[m_capacity]())), ...);
+    }
+
+    template<std::size_t... I>
+    void store(const std::size_t row, const Frame &frame, std::index_sequence<I...>)
+    {
+        ((std::get<I>(m_columns)[row] = frame.*(std::get<I>(Schema<Frame>::fields).member)),
+         ...);
+    }
+
+    template<typename T>
+    ColumnView<T> view(const T *data) const
+    {
+        ColumnView<T> result;
+        if (m_size < m_capacity)
+        {
+            result.first = data;
+            result.firstSize = m_size;
+        }
+
+        else
+        {
+            result.first = data + m_head;
+            result.firstSize = m_capacity - m_head;
+            result.second = data;
+            result.secondSize = m_head;
+        }
+
+        return result;
+    }
+
+private:
+    std::size_t m_head;
+    std::size_t m_size;
+    std::size_t m_capacity;
+
+    Columns m_columns;
+    std::unique_ptr<qint64[]> m_timestamps;
+};
+}
@@ -0,0 +1,240 @@
+/*
+ * Copyright (c) 2022 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "Console.h"
+
+#include <QMetaMethod>
+
+#include <Misc/TimerEvents.h>
+
+/*
+ * Maximum number of lines stored by the console
+ */
+static constexpr int MAX_LINES = 5000;
+
+/*
+ * Lines longer than this are truncated
+ */
+static constexpr int MAX_LINE_LENGTH = 1024;
+
+/*
+ * Maximum number of raw data lines published on each user interface update,
+ * additional data lines are suppressed
+ */
+static constexpr int MAX_LINES_PER_UPDATE = 64;
+
+/*
+ * Maximum number of lines queued between two user interface updates, only reached if
+ * the console is flooded with messages
+ */
+static constexpr int MAX_PENDING_LINES = 1024;
+
+/**
+ * Constructor function
+ */
+Misc::Console::Console()
+    : m_first(0)
+    , m_count(0)
+    , m_pendingData(0)
+    , m_suppressed(0)
+    , m_suppressedTotal(0)
+{
+    m_pending.reserve(MAX_LINES_PER_UPDATE);
+    connect(&Misc::TimerEvents::instance(), &Misc::TimerEvents::timeout20Hz, this,
+            &Misc::Console::publishPendingLines);
+}
+
+/**
+ * Returns a pointer to the only instance of the class
+ */
+Misc::Console &Misc::Console::instance()
+{
+    static Console singleton;
+    return singleton;
+}
+
+/**
+ * Returns the maximum number of lines stored by the console
+ */
+int Misc::Console::capacity() const
+{
+    return MAX_LINES;
+}
+
+/**
+ * Returns the number of raw data lines that were suppressed by the rate limiter since
+ * the application started
+ */
+quint64 Misc::Console::suppressedLines() const
+{
+    return m_suppressedTotal;
+}
+
+/**
+ * Returns the number of lines stored by the console
+ */
+int Misc::Console::rowCount(const QModelIndex &parent) const
+{
+    if (parent.isValid())
+        return 0;
+
+    return m_count;
+}
+
+/**
+ * Returns the text of the line at the given @a index
+ */
+QVariant Misc::Console::data(const QModelIndex &index, int role) const
+{
+    if (!index.isValid() || index.row() >= m_count)
+        return QVariant();
+
+    if (role == LineRole || role == Qt::DisplayRole)
+        return m_lines.at((m_first + index.row()) % MAX_LINES);
+
+    return QVariant();
+}
+
+/**
+ * Returns the role names used by the QML delegates
+ */
+QHash<int, QByteArray> Misc::Console::roleNames() const
+{
+    QHash<int, QByteArray> names;
+    names.insert(LineRole, "line");
+    return names;
+}
+
+/**
+ * Removes all the lines of the console
+ */
+void Misc::Console::clear()
+{
+    beginResetModel();
+    m_lines.clear();
+    m_pending.clear();
+    m_pendingData = 0;
+    m_suppressed = 0;
+    m_first = 0;
+    m_count = 0;
+    endResetModel();
+}
+
+/**
+ * Queues the given @a line, it is displayed on the next user interface update. Text
+ * lines (e.g. warnings & errors) are not subject to the per-update limit of the raw
+ * data lines.
+ */
+void Misc::Console::append(const QString &line)
+{
+    if (m_pending.size() < MAX_PENDING_LINES)
+        m_pending.append({ line, QByteArray() });
+    else
+        ++m_suppressed;
+}
+
+/**
+ * Queues a line made of the given @a prefix and the UTF-8 text in @a data, the data is
+ * only decoded if the line is displayed
+ */
+void Misc::Console::appendData(const QString &prefix, const QByteArray &data)
+{
+    if (m_pendingData < MAX_LINES_PER_UPDATE && m_pending.size() < MAX_PENDING_LINES)
+    {
+        m_pending.append({ prefix, data });
+        ++m_pendingData;
+    }
+
+    else
+        ++m_suppressed;
+}
+
+/**
+ * Inserts the queued lines into the model in a single batch, discarding the oldest
+ * lines if the console is full
+ */
+void Misc::Console::publishPendingLines()
+{
+    // Nothing to publish
+    if (m_pending.isEmpty() && m_suppressed == 0)
+        return;
+
+    // Report suppressed lines
+    if (m_suppressed > 0)
+    {
+        m_suppressedTotal += m_suppressed;
+        m_pending.append({ QString(" [Console] %1 lines suppressed").arg(m_suppressed),
+                           QByteArray() });
+        m_suppressed = 0;
+    }
+
+    // Discard oldest lines
+    const auto lines = static_cast<int>(m_pending.size());
+    const auto overflow = m_count + lines - MAX_LINES;
+    if (overflow > 0)
+    {
+        beginRemoveRows(QModelIndex(), 0, overflow - 1);
+        m_first = (m_first + overflow) % MAX_LINES;
+        m_count -= overflow;
+        endRemoveRows();
+    }
+
+    // Only build the list of published lines if someone listens to it
+    QStringList published;
+    const auto report = isSignalConnected(QMetaMethod::fromSignal(&Console::linesPublished));
+
+    // Store lines in the ring
+    beginInsertRows(QModelIndex(), m_count, m_count + lines - 1);
+    for (const auto &line : qAsConst(m_pending))
+    {
+        const auto text = line.data.isEmpty() ? line.text
+                                              : line.text + QString::fromUtf8(line.data);
+        store(text);
+
+        if (report)
+            published.append(text);
+    }
+    endInsertRows();
+
+    // Reset pending lines
+    m_pending.clear();
+    m_pendingData = 0;
+
+    // Report published lines
+    if (report)
+        Q_EMIT linesPublished(published);
+}
+
+/**
+ * Stores the given @a line after the last line of the ring, the caller must make sure
+ * that the ring has room for it
+ */
+void Misc::Console::store(const QString &line)
+{
+    const auto slot = (m_first + m_count) % MAX_LINES;
+    if (m_lines.size() <= slot)
+        m_lines.append(line.left(MAX_LINE_LENGTH));
+    else
+        m_lines[slot] = line.left(MAX_LINE_LENGTH);
+
+    ++m_count;
+}
@@ -0,0 +1,109 @@
+/*
+ * Copyright (c) 2022 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#pragma once
+
+#include <QVector>
+#include <QStringList>
+#include <QAbstractListModel>
+
+namespace Misc
+{
+/**
+ * @brief The Console class
+ *
+ * The @c Console class stores the lines displayed by the console of the user
+ * interface in a fixed-capacity ring. Once the ring is full, the oldest line is
+ * discarded for each new line, so that appending a line has a constant cost and the
+ * memory used by the console is capped, regardless of the length of the session.
+ *
+ * New lines are not published immediately: they are gathered in a pending list and
+ * inserted into the model in a single batch on each user interface update (20 Hz).
+ * Raw data lines (e.g. received frames) received in excess of the per-update limit
+ * are not stored, only counted, and a single notice reports how many lines were
+ * suppressed. Text lines, such as warnings & errors, are not rate limited, so they do
+ * not vanish during bursts of received data. Raw data lines are only decoded to text
+ * if they are actually displayed.
+ *
+ * The model is meant to be displayed with a @c ListView, which only creates delegates
+ * for the visible lines. Each published batch is also reported with the
+ * @c linesPublished() signal, which is used to print the console in headless mode.
+ */
+class Console : public QAbstractListModel
+{
+    // clang-format off
+    Q_OBJECT
+    // clang-format on
+
+Q_SIGNALS:
+    void linesPublished(const QStringList &lines);
+
+public:
+    enum Roles
+    {
+        LineRole = Qt::UserRole + 1,
+    };
+
+private:
+    Console();
+    Console(Console &&) = delete;
+    Console(const Console &) = delete;
+    Console &operator=(Console &&) = delete;
+    Console &operator=(const Console &) = delete;
+
+public:
+    static Console &instance();
+
+    int capacity() const;
+    quint64 suppressedLines() const;
+    int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
+    QHash<int, QByteArray> roleNames() const override;
+
+public Q_SLOTS:
+    void clear();
+    void append(const QString &line);
+    void appendData(const QString &prefix, const QByteArray &data);
+
+private Q_SLOTS:
+    void publishPendingLines();
+
+private:
+    void store(const QString &line);
+
+private:
+    struct PendingLine
+    {
+        QString text;
+        QByteArray data;
+    };
+
+    int m_first;
+    int m_count;
+    QVector<QString> m_lines;
+
+    int m_pendingData;
+    quint64 m_suppressed;
+    quint64 m_suppressedTotal;
+    QVector<PendingLine> m_pending;
+};
+}
@@ -0,0 +1,161 @@
+/*
+ * Copyright (c) 2022 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "LatencyHistogram.h"
+
+#include <cmath>
+
+/*
+ * Number of bits used for the linear sub-buckets of each power of two
+ */
+static constexpr int SUB_BUCKET_BITS = 5;
+static constexpr int SUB_BUCKETS = 1 << SUB_BUCKET_BITS;
+
+/*
+ * Largest power of two that can be recorded, larger values are clamped
+ */
+static constexpr int MAX_EXPONENT = 40;
+static constexpr quint64 MAX_VALUE = (quint64(1) << (MAX_EXPONENT + 1)) - 1;
+static constexpr int BUCKET_COUNT = SUB_BUCKETS * (MAX_EXPONENT - SUB_BUCKET_BITS + 2);
+
+/**
+ * Constructor function
+ */
+Misc::LatencyHistogram::LatencyHistogram()
+    : m_buckets(BUCKET_COUNT, 0)
+{
+    clear();
+}
+
+/**
+ * Returns the number of recorded samples
+ */
+quint64 Misc::LatencyHistogram::count() const
+{
+    return m_count;
+}
+
+/**
+ * Returns the smallest recorded sample
+ */
+qint64 Misc::LatencyHistogram::min() const
+{
+    return m_count > 0 ? m_min : 0;
+}
+
+/**
+ * Returns the largest recorded sample
+ */
+qint64 Misc::LatencyHistogram::max() const
+{
+    return m_max;
+}
+
+/**
+ * Returns the average of the recorded samples
+ */
+double Misc::LatencyHistogram::mean() const
+{
+    return m_count > 0 ? m_sum / m_count : 0;
+}
+
+/**
+ * Returns the value below which the given @a percentile (0-100) of the samples fall.
+ * The value is the upper bound of the bucket that contains the percentile, capped by
+ * the largest recorded sample.
+ */
+qint64 Misc::LatencyHistogram::percentile(const double percentile) const
+{
+    if (m_count == 0)
+        return 0;
+
+    const auto p = qBound(0.0, percentile, 100.0) / 100.0;
+    const auto target = qMax<quint64>(1, static_cast<quint64>(std::ceil(p * m_count)));
+
+    quint64 seen = 0;
+    for (int i = 0; i < m_buckets.count(); ++i)
+    {
+        seen += m_buckets.at(i);
+        if (seen >= target)
+            return qMin<qint64>(m_max, static_cast<qint64>(bucketUpperBound(i)));
+    }
+
+    return m_max;
+}
+
+/**
+ * Removes all the recorded samples
+ */
+void Misc::LatencyHistogram::clear()
+{
+    m_count = 0;
+    m_min = 0;
+    m_max = 0;
+    m_sum = 0;
+    m_buckets.fill(0);
+}
+
+/**
+ * Adds the given @a value to the histogram, negative values are recorded as zero
+ */
+void Misc::LatencyHistogram::record(qint64 value)
+{
+    value = qMax<qint64>(0, value);
+
+    if (m_count == 0 || value < m_min)
+        m_min = value;
+    if (value > m_max)
+        m_max = value;
+
+    m_sum += value;
+    m_count += 1;
+    m_buckets[bucketIndex(static_cast<quint64>(value))] += 1;
+}
+
+/**
+ * Returns the index of the bucket that contains the given @a value
+ */
+int Misc::LatencyHistogram::bucketIndex(const quint64 value)
+{
+    const auto v = qMin(value, MAX_VALUE);
+    if (v < SUB_BUCKETS)
+        return static_cast<int>(v);
+
+    const int exponent = 63 - qCountLeadingZeroBits(v);
+    const int shift = exponent - SUB_BUCKET_BITS;
+    const int subBucket = static_cast<int>(v >> shift) - SUB_BUCKETS;
+    return SUB_BUCKETS + shift * SUB_BUCKETS + subBucket;
+}
+
+/**
+ * Returns the largest value that belongs to the bucket at the given @a index
+ */
+quint64 Misc::LatencyHistogram::bucketUpperBound(const int index)
+{
+    if (index < SUB_BUCKETS)
+        return static_cast<quint64>(index);
+
+    const int shift = (index - SUB_BUCKETS) / SUB_BUCKETS;
+    const int subBucket = (index - SUB_BUCKETS) % SUB_BUCKETS;
+    const quint64 lower = quint64(SUB_BUCKETS + subBucket) << shift;
+    return lower + (quint64(1) << shift) - 1;
+}
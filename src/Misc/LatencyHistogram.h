@@ -0,0 +1,65 @@
+/*
+ * Copyright (c) 2022 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#pragma once
+
+#include <QVector>
+#include <QtGlobal>
+
+namespace Misc
+{
+/**
+ * @brief The LatencyHistogram class
+ *
+ * HDR-style histogram of latency samples. Values are grouped in buckets whose width
+ * grows with their magnitude: each power of two is split into 32 linear sub-buckets,
+ * so percentiles are reported with a relative error below 3% over the whole range,
+ * using a fixed amount of memory. Recording a value is a constant-time operation.
+ *
+ * The histogram is unit-agnostic, the control panel records microseconds.
+ */
+class LatencyHistogram
+{
+public:
+    LatencyHistogram();
+
+    quint64 count() const;
+    qint64 min() const;
+    qint64 max() const;
+    double mean() const;
+    qint64 percentile(const double percentile) const;
+
+    void clear();
+    void record(qint64 value);
+
+private:
+    static int bucketIndex(const quint64 value);
+    static quint64 bucketUpperBound(const int index);
+
+private:
+    quint64 m_count;
+    qint64 m_min;
+    qint64 m_max;
+    double m_sum;
+    QVector<quint32> m_buckets;
+};
+}
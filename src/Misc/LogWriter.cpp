@@ -0,0 +1,313 @@
+/*
+ * Copyright (c) 2022 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <Misc/LogWriter.h>
+
+#ifdef Q_OS_WIN
+#    include <io.h>
+#else
+#    include <unistd.h>
+#endif
+
+/*
+ * Pending data is written as soon as it exceeds this size
+ */
+static constexpr qsizetype BATCH_SIZE = 256 * 1024;
+
+/*
+ * Pending data is dropped if the disk cannot keep up & it grows beyond this size
+ */
+static constexpr qsizetype MAX_PENDING_SIZE = 64 * 1024 * 1024;
+
+/**
+ * Constructor function
+ */
+Misc::LogWriter::LogWriter()
+    : m_pendingRecords(0)
+    , m_failedBytes(0)
+    , m_droppedBytes(0)
+    , m_flushRequested(false)
+    , m_syncRequested(false)
+    , m_stop(false)
+{
+}
+
+/**
+ * Writes any pending data & closes the log file
+ */
+Misc::LogWriter::~LogWriter()
+{
+    close();
+}
+
+/**
+ * Returns @c true if the log file is open
+ */
+bool Misc::LogWriter::isOpen() const
+{
+    return m_thread != nullptr;
+}
+
+/**
+ * Returns the path of the log file
+ */
+QString Misc::LogWriter::fileName() const
+{
+    return m_file.fileName();
+}
+
+/**
+ * Returns a description of the last error that occurred while opening the file
+ */
+QString Misc::LogWriter::errorString() const
+{
+    return m_file.errorString();
+}
+
+/**
+ * Returns the number of bytes that the writer thread could not write to the file
+ * (failed or short writes, e.g. because the disk is full)
+ */
+quint64 Misc::LogWriter::failedBytes() const
+{
+    QMutexLocker locker(&m_mutex);
+    return m_failedBytes;
+}
+
+/**
+ * Returns the number of bytes that were discarded because the disk did not keep up
+ * with the amount of logged data
+ */
+quint64 Misc::LogWriter::droppedBytes() const
+{
+    QMutexLocker locker(&m_mutex);
+    return m_droppedBytes;
+}
+
+/**
+ * Returns a description of the last error that occurred while writing to the file
+ */
+QString Misc::LogWriter::writeErrorString() const
+{
+    QMutexLocker locker(&m_mutex);
+    return m_writeError;
+}
+
+/**
+ * Returns the current flush policy
+ */
+Misc::LogWriter::Policy Misc::LogWriter::policy() const
+{
+    QMutexLocker locker(&m_mutex);
+    return m_policy;
+}
+
+/**
+ * Changes the flush policy, takes effect on the next flush
+ */
+void Misc::LogWriter::setPolicy(const Policy &policy)
+{
+    QMutexLocker locker(&m_mutex);
+    m_policy = policy;
+    m_condition.wakeAll();
+}
+
+/**
+ * Creates the log file at the given @a fileName & starts the writer thread.
+ * Returns @c false if the file cannot be created.
+ */
+bool Misc::LogWriter::open(const QString &fileName)
+{
+    close();
+
+    m_file.setFileName(fileName);
+    if (!m_file.open(QFile::WriteOnly | QFile::Unbuffered))
+        return false;
+
+    m_stop = false;
+    m_pendingRecords = 0;
+    m_flushRequested = false;
+    m_syncRequested = false;
+    m_pending.reserve(BATCH_SIZE);
+
+    m_thread.reset(QThread::create([this]() { run(); }));
+    m_thread->setObjectName("LogWriter");
+    m_thread->start();
+    return true;
+}
+
+/**
+ * Writes & commits all pending data to disk, stops the writer thread and closes the
+ * log file.
+ */
+void Misc::LogWriter::close()
+{
+    if (!m_thread)
+        return;
+
+    {
+        QMutexLocker locker(&m_mutex);
+        m_stop = true;
+        m_condition.wakeAll();
+    }
+
+    m_thread->wait();
+    m_thread.reset();
+    m_file.close();
+}
+
+/**
+ * Adds the given @a record to the log, it is written to disk by the writer thread
+ * according to the flush policy.
+ */
+void Misc::LogWriter::append(QByteArrayView record)
+{
+    appendData(record, false);
+}
+
+/**
+ * Adds the given @a line to the log, followed by a line break
+ */
+void Misc::LogWriter::appendLine(QByteArrayView line)
+{
+    appendData(line, true);
+}
+
+/**
+ * Writes all pending data & commits the log file to disk as soon as possible (e.g.
+ * after the CanSat changes its flight state).
+ */
+void Misc::LogWriter::sync()
+{
+    QMutexLocker locker(&m_mutex);
+    requestFlush(true);
+}
+
+/**
+ * Adds the given @a data to the pending data, optionally followed by a line break,
+ * and wakes up the writer thread if the flush policy requires it. The record is
+ * dropped (and counted) if the pending data would grow beyond its maximum size.
+ */
+void Misc::LogWriter::appendData(QByteArrayView data, const bool lineBreak)
+{
+    QMutexLocker locker(&m_mutex);
+    const auto size = data.size() + (lineBreak ? 1 : 0);
+    if (m_pending.size() + size > MAX_PENDING_SIZE)
+    {
+        m_droppedBytes += size;
+        return;
+    }
+
+    m_pending.append(data.data(), data.size());
+    if (lineBreak)
+        m_pending.append('\n');
+
+    ++m_pendingRecords;
+    if (m_pending.size() >= BATCH_SIZE
+        || (m_policy.flushFrames > 0 && m_pendingRecords >= m_policy.flushFrames))
+        requestFlush(false);
+}
+
+/**
+ * Wakes up the writer thread, must be called with the data mutex locked
+ */
+void Misc::LogWriter::requestFlush(const bool sync)
+{
+    m_flushRequested = true;
+    m_syncRequested |= sync;
+    m_condition.wakeAll();
+}
+
+/**
+ * Writer thread loop, swaps the pending data with an empty buffer & writes it to the
+ * file while producers keep appending new data.
+ */
+void Misc::LogWriter::run()
+{
+    QByteArray batch;
+    batch.reserve(BATCH_SIZE);
+
+    QMutexLocker locker(&m_mutex);
+    while (true)
+    {
+        // Wait until a flush is requested or the flush interval expires
+        if (!m_flushRequested && !m_stop)
+        {
+            if (m_policy.flushInterval > 0)
+                m_condition.wait(&m_mutex, static_cast<ulong>(m_policy.flushInterval));
+            else
+                m_condition.wait(&m_mutex);
+        }
+
+        // Take pending data
+        const bool stop = m_stop;
+        const bool sync = m_syncRequested || stop;
+        m_pending.swap(batch);
+        m_pendingRecords = 0;
+        m_flushRequested = false;
+        m_syncRequested = false;
+
+        // Write data without blocking producers, count the bytes that were not written
+        locker.unlock();
+        qint64 failed = 0;
+        QString error;
+        if (!batch.isEmpty())
+        {
+            const auto written = m_file.write(batch);
+            if (written < batch.size())
+            {
+                failed = batch.size() - qMax<qint64>(written, 0);
+                error = m_file.errorString();
+            }
+        }
+
+        if (sync)
+            commitToDisk(m_file);
+
+        batch.resize(0);
+        locker.relock();
+
+        // Register write errors
+        if (failed > 0)
+        {
+            m_failedBytes += failed;
+            m_writeError = error;
+        }
+
+        // Exit once everything has been written
+        if (stop && m_pending.isEmpty())
+            break;
+    }
+}
+
+/**
+ * Asks the operating system to write the file contents to the storage device
+ */
+void Misc::LogWriter::commitToDisk(QFile &file)
+{
+    file.flush();
+#ifdef Q_OS_WIN
+    _commit(file.handle());
+#else
+    ::fsync(file.handle());
+#endif
+}
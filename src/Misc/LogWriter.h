@@ -0,0 +1,109 @@
+/*
+ * Copyright (c) 2022 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#pragma once
+
+#include <QFile>
+#include <QMutex>
+#include <QThread>
+#include <QByteArray>
+#include <QWaitCondition>
+
+#include <memory>
+
+namespace Misc
+{
+/**
+ * @brief The LogWriter class
+ *
+ * Appends data to a log file from a background thread. Data is accumulated in memory
+ * and written in large batches (group commit), so that the threads producing log data
+ * are never blocked by disk latency.
+ *
+ * The flush policy defines how much data may be lost if the application crashes:
+ * pending data is written at least every @c flushInterval milliseconds and, if
+ * @c flushFrames is not zero, as soon as that many records are pending. Calling
+ * @c sync() writes pending data & asks the operating system to commit the file to
+ * disk, which also protects it against power loss.
+ *
+ * Data that cannot be logged is counted instead of being silently discarded: records
+ * dropped because the disk does not keep up (@c droppedBytes()) and batches that the
+ * writer thread could not write completely, e.g. because the disk is full
+ * (@c failedBytes() & @c writeErrorString()).
+ */
+class LogWriter
+{
+public:
+    struct Policy
+    {
+        int flushInterval = 1000;
+        int flushFrames = 0;
+    };
+
+    LogWriter();
+    ~LogWriter();
+
+    LogWriter(LogWriter &&) = delete;
+    LogWriter(const LogWriter &) = delete;
+    LogWriter &operator=(LogWriter &&) = delete;
+    LogWriter &operator=(const LogWriter &) = delete;
+
+    bool isOpen() const;
+    QString fileName() const;
+    QString errorString() const;
+    quint64 failedBytes() const;
+    quint64 droppedBytes() const;
+    QString writeErrorString() const;
+
+    Policy policy() const;
+    void setPolicy(const Policy &policy);
+
+    bool open(const QString &fileName);
+    void close();
+
+    void append(QByteArrayView record);
+    void appendLine(QByteArrayView line);
+    void sync();
+
+private:
+    void run();
+    void appendData(QByteArrayView data, const bool lineBreak);
+    void requestFlush(const bool sync);
+    static void commitToDisk(QFile &file);
+
+private:
+    QFile m_file;
+    Policy m_policy;
+    std::unique_ptr<QThread> m_thread;
+
+    mutable QMutex m_mutex;
+    QWaitCondition m_condition;
+    QByteArray m_pending;
+    int m_pendingRecords;
+    quint64 m_failedBytes;
+    quint64 m_droppedBytes;
+    QString m_writeError;
+    bool m_flushRequested;
+    bool m_syncRequested;
+    bool m_stop;
+};
+}
@@ -0,0 +1,178 @@
+/*
+ * Copyright (c) 2022 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "Notifications.h"
+
+#include <QThread>
+
+/*
+ * Maximum number of notifications displayed at the same time
+ */
+static constexpr int MAX_NOTIFICATIONS = 5;
+
+/**
+ * Constructor function
+ */
+Misc::Notifications::Notifications()
+    : m_nextId(1)
+{
+}
+
+/**
+ * Returns a pointer to the only instance of the class
+ */
+Misc::Notifications &Misc::Notifications::instance()
+{
+    static Notifications singleton;
+    return singleton;
+}
+
+/**
+ * Returns the number of open notifications
+ */
+int Misc::Notifications::rowCount(const QModelIndex &parent) const
+{
+    if (parent.isValid())
+        return 0;
+
+    return m_notifications.count();
+}
+
+/**
+ * Returns the value of the given @a role for the notification at @a index
+ */
+QVariant Misc::Notifications::data(const QModelIndex &index, int role) const
+{
+    if (!index.isValid() || index.row() >= m_notifications.count())
+        return QVariant();
+
+    const auto &notification = m_notifications.at(index.row());
+    switch (role)
+    {
+        case IdRole:
+            return notification.id;
+        case LevelRole:
+            return notification.level;
+        case TitleRole:
+            return notification.title;
+        case TextRole:
+            return notification.text;
+        case CountRole:
+            return notification.count;
+        case TimeRole:
+            return notification.time.toString("HH:mm:ss");
+        default:
+            return QVariant();
+    }
+}
+
+/**
+ * Returns the role names used by the QML delegates
+ */
+QHash<int, QByteArray> Misc::Notifications::roleNames() const
+{
+    QHash<int, QByteArray> names;
+    names.insert(IdRole, "uid");
+    names.insert(LevelRole, "level");
+    names.insert(TitleRole, "title");
+    names.insert(TextRole, "text");
+    names.insert(CountRole, "count");
+    names.insert(TimeRole, "time");
+    return names;
+}
+
+/**
+ * Closes all the notifications
+ */
+void Misc::Notifications::clear()
+{
+    beginResetModel();
+    m_notifications.clear();
+    endResetModel();
+}
+
+/**
+ * Closes the notification with the given @a id
+ */
+void Misc::Notifications::dismiss(const quint64 id)
+{
+    for (int i = 0; i < m_notifications.count(); ++i)
+    {
+        if (m_notifications.at(i).id == id)
+        {
+            beginRemoveRows(QModelIndex(), i, i);
+            m_notifications.removeAt(i);
+            endRemoveRows();
+            return;
+        }
+    }
+}
+
+/**
+ * Queues a notification with the given @a level, @a title & @a text. If the function
+ * is called from another thread, the notification is posted to the main thread.
+ */
+void Misc::Notifications::post(const Misc::Notifications::Level level,
+                               const QString &title, const QString &text)
+{
+    // Post notification from the thread of the model
+    if (QThread::currentThread() != thread())
+    {
+        QMetaObject::invokeMethod(
+            this, [=] { post(level, title, text); }, Qt::QueuedConnection);
+        return;
+    }
+
+    // Report notification
+    Q_EMIT posted(level, title, text);
+
+    // Merge repeated notifications
+    for (int i = 0; i < m_notifications.count(); ++i)
+    {
+        auto &notification = m_notifications[i];
+        if (notification.title == title && notification.text == text)
+        {
+            notification.count += 1;
+            notification.level = qMax(notification.level, level);
+            notification.time = QDateTime::currentDateTime();
+
+            const auto idx = index(i);
+            Q_EMIT dataChanged(idx, idx, { LevelRole, CountRole, TimeRole });
+            return;
+        }
+    }
+
+    // Discard oldest notification
+    if (m_notifications.count() >= MAX_NOTIFICATIONS)
+    {
+        beginRemoveRows(QModelIndex(), 0, 0);
+        m_notifications.removeFirst();
+        endRemoveRows();
+    }
+
+    // Add notification
+    const auto row = m_notifications.count();
+    beginInsertRows(QModelIndex(), row, row);
+    m_notifications.append(
+        { m_nextId++, level, title, text, 1, QDateTime::currentDateTime() });
+    endInsertRows();
+}
@@ -0,0 +1,107 @@
+/*
+ * Copyright (c) 2022 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#pragma once
+
+#include <QVector>
+#include <QDateTime>
+#include <QAbstractListModel>
+
+namespace Misc
+{
+/**
+ * @brief The Notifications class
+ *
+ * The @c Notifications class implements an asynchronous notification queue, which
+ * is displayed by the user interface as non-modal toasts. Unlike modal message boxes,
+ * posting a notification does not start a nested event loop, so that the telemetry &
+ * simulation pipelines keep running while the operator reads an alert.
+ *
+ * Notifications can be posted from any thread. Repeated notifications with the same
+ * title & text are merged into the existing toast (its counter is increased), and
+ * the oldest toasts are discarded when too many of them are open. Every posted
+ * notification is also reported with the @c posted() signal.
+ */
+class Notifications : public QAbstractListModel
+{
+    // clang-format off
+    Q_OBJECT
+    // clang-format on
+
+public:
+    enum Level
+    {
+        Info,
+        Warning,
+        Critical,
+    };
+    Q_ENUM(Level)
+
+    enum Roles
+    {
+        IdRole = Qt::UserRole + 1,
+        LevelRole,
+        TitleRole,
+        TextRole,
+        CountRole,
+        TimeRole,
+    };
+
+Q_SIGNALS:
+    void posted(const Misc::Notifications::Level level, const QString &title,
+                const QString &text);
+
+private:
+    Notifications();
+    Notifications(Notifications &&) = delete;
+    Notifications(const Notifications &) = delete;
+    Notifications &operator=(Notifications &&) = delete;
+    Notifications &operator=(const Notifications &) = delete;
+
+public:
+    static Notifications &instance();
+
+    int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
+    QHash<int, QByteArray> roleNames() const override;
+
+public Q_SLOTS:
+    void clear();
+    void dismiss(const quint64 id);
+    void post(const Misc::Notifications::Level level, const QString &title,
+              const QString &text);
+
+private:
+    struct Notification
+    {
+        quint64 id;
+        Level level;
+        QString title;
+        QString text;
+        int count;
+        QDateTime time;
+    };
+
+    quint64 m_nextId;
+    QVector<Notification> m_notifications;
+};
+}
@@ -0,0 +1,190 @@
+/*
+ * Copyright (c) 2022 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#pragma once
+
+#include <charconv>
+#include <cstdint>
+#include <system_error>
+
+namespace Misc
+{
+/**
+ * @brief Allocation-free number parsing functions
+ *
+ * The functions follow the conventions of @c std::from_chars(): they parse a number
+ * from the beginning of the [@a first, @a last) range and return a pointer to the
+ * first character that is not part of the number, or @a first if no number could be
+ * parsed (in which case @a value is not modified).
+ */
+namespace NumberParser
+{
+/**
+ * Decimal exponents are clamped to this value, which is enough to turn any mantissa
+ * into infinity or zero & keeps corrupted exponents from overflowing
+ */
+static constexpr int MAX_EXPONENT = 400;
+
+/**
+ * Parses an integer number
+ */
+template<typename T>
+inline const char *parseInteger(const char *first, const char *last, T &value)
+{
+    // std::from_chars() does not accept a leading plus sign, reject a second sign
+    auto begin = first;
+    if (begin != last && *begin == '+')
+    {
+        ++begin;
+        if (begin != last && (*begin == '-' || *begin == '+'))
+            return first;
+    }
+
+    const auto result = std::from_chars(begin, last, value);
+    if (result.ec != std::errc())
+        return first;
+
+    return result.ptr;
+}
+
+/**
+ * Parses a decimal number with an optional sign, fractional part & exponent.
+ *
+ * Numbers with up to 15 significant digits & small exponents (the format used in
+ * telemetry frames) are converted exactly, longer numbers are rounded. Exponents
+ * beyond @c MAX_EXPONENT are clamped, so the result becomes infinity or zero.
+ */
+inline const char *parseDecimal(const char *first, const char *last, double &value)
+{
+    // clang-format off
+    static constexpr double POW10[] = {
+        1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+        1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+    };
+    // clang-format on
+
+    // Read sign
+    auto p = first;
+    bool negative = false;
+    if (p != last && (*p == '-' || *p == '+'))
+        negative = (*p++ == '-');
+
+    // Read integer & fractional digits into the mantissa
+    int digits = 0;
+    int exponent = 0;
+    bool anyDigit = false;
+    std::uint64_t mantissa = 0;
+    for (; p != last && *p >= '0' && *p <= '9'; ++p)
+    {
+        anyDigit = true;
+        if (digits < 19)
+        {
+            mantissa = mantissa * 10 + static_cast<unsigned>(*p - '0');
+            digits += (mantissa != 0);
+        }
+
+        else if (exponent < MAX_EXPONENT)
+            ++exponent;
+    }
+
+    if (p != last && *p == '.')
+    {
+        for (++p; p != last && *p >= '0' && *p <= '9'; ++p)
+        {
+            anyDigit = true;
+            if (digits < 19)
+            {
+                mantissa = mantissa * 10 + static_cast<unsigned>(*p - '0');
+                digits += (mantissa != 0);
+                --exponent;
+            }
+        }
+    }
+
+    // No digits found
+    if (!anyDigit)
+        return first;
+
+    // Read exponent (only consumed if it contains digits)
+    if (p != last && (*p == 'e' || *p == 'E'))
+    {
+        auto q = p + 1;
+        bool negativeExponent = false;
+        if (q != last && (*q == '-' || *q == '+'))
+            negativeExponent = (*q++ == '-');
+
+        int e = 0;
+        const auto begin = q;
+        for (; q != last && *q >= '0' && *q <= '9'; ++q)
+        {
+            e = e * 10 + (*q - '0');
+            if (e > MAX_EXPONENT)
+                e = MAX_EXPONENT;
+        }
+
+        if (q != begin)
+        {
+            exponent += negativeExponent ? -e : e;
+            p = q;
+        }
+    }
+
+    // Scale mantissa
+    auto result = static_cast<double>(mantissa);
+    if (mantissa != 0)
+    {
+        while (exponent > 22)
+        {
+            result *= POW10[22];
+            exponent -= 22;
+        }
+
+        while (exponent < -22)
+        {
+            result /= POW10[22];
+            exponent += 22;
+        }
+
+        if (exponent > 0)
+            result *= POW10[exponent];
+        else if (exponent < 0)
+            result /= POW10[-exponent];
+    }
+
+    value = negative ? -result : result;
+    return p;
+}
+
+/**
+ * Parses a decimal number into a single precision value
+ */
+inline const char *parseDecimal(const char *first, const char *last, float &value)
+{
+    double result = 0;
+    const auto end = parseDecimal(first, last, result);
+    if (end != first)
+        value = static_cast<float>(result);
+
+    return end;
+}
+}
+}
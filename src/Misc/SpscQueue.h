@@ -0,0 +1,110 @@
+/*
+ * Copyright (c) 2022 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <utility>
+
+namespace Misc
+{
+/**
+ * @brief The SpscQueue class
+ *
+ * Fixed-capacity, lock-free queue that allows one thread to produce items while
+ * another thread consumes them. Neither side ever blocks: @c push() fails when the
+ * queue is full and @c pop() fails when the queue is empty.
+ *
+ * @note @a Capacity must be a power of two.
+ */
+template<typename T, std::size_t Capacity>
+class SpscQueue
+{
+    static_assert(Capacity > 0 && (Capacity & (Capacity - 1)) == 0,
+                  "SpscQueue capacity must be a power of two");
+
+public:
+    SpscQueue()
+        : m_head(0)
+        , m_tail(0)
+    {
+    }
+
+    SpscQueue(SpscQueue &&) = delete;
+    SpscQueue(const SpscQueue &) = delete;
+    SpscQueue &operator=(SpscQueue &&) = delete;
+    SpscQueue &operator=(const SpscQueue &) = delete;
+
+    /**
+     * Returns the maximum number of items that the queue can hold
+     */
+    static constexpr std::size_t capacity() { return Capacity; }
+
+    /**
+     * Returns the approximate number of items in the queue
+     */
+    std::size_t size() const
+    {
+        return m_tail.load(std::memory_order_acquire)
+               - m_head.load(std::memory_order_acquire);
+    }
+
+    /**
+     * Adds the given @a item to the queue, returns @c false if the queue is full.
+     * Must only be called from the producer thread.
+     */
+    bool push(T &&item)
+    {
+        const auto tail = m_tail.load(std::memory_order_relaxed);
+        if (tail - m_head.load(std::memory_order_acquire) == Capacity)
+            return false;
+
+        m_items[tail & (Capacity - 1)] = std::move(item);
+        m_tail.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * Moves the oldest item of the queue to @a item, returns @c false if the queue
+     * is empty. Must only be called from the consumer thread.
+     */
+    bool pop(T &item)
+    {
+        const auto head = m_head.load(std::memory_order_relaxed);
+        if (head == m_tail.load(std::memory_order_acquire))
+            return false;
+
+        auto &slot = m_items[head & (Capacity - 1)];
+        item = std::move(slot);
+        slot = T();
+        m_head.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+private:
+    alignas(64) std::atomic<std::size_t> m_head;
+    alignas(64) std::atomic<std::size_t> m_tail;
+    std::array<T, Capacity> m_items;
+};
+}
@@ -0,0 +1,69 @@
+/*
+ * Copyright (c) 2022 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#pragma once
+
+#include <QByteArray>
+
+namespace Misc
+{
+/**
+ * @brief Helper functions for the buffers of streaming parsers
+ *
+ * Streaming parsers append received data to a buffer and consume it from the front.
+ * Instead of removing every consumed byte right away, they periodically call
+ * @c compact() and shift their read positions by the returned amount.
+ */
+namespace StreamBuffer
+{
+/**
+ * Consumed bytes are removed from the buffer once they exceed this size and
+ * represent at least half of the buffer
+ */
+static constexpr qsizetype COMPACT_THRESHOLD = 64 * 1024;
+
+/**
+ * Removes the first @a consumed bytes of the @a buffer if they are large enough to be
+ * worth moving the remaining data around. If everything was consumed, the buffer is
+ * emptied without freeing its memory.
+ *
+ * Returns the number of bytes removed from the front of the buffer, which must be
+ * subtracted from the positions that the caller keeps in it.
+ */
+inline qsizetype compact(QByteArray &buffer, const qsizetype consumed)
+{
+    // Everything has been consumed, reset the buffer without freeing it
+    if (consumed > 0 && consumed == buffer.size())
+    {
+        buffer.resize(0);
+        return consumed;
+    }
+
+    // Only compact when consumed data dominates the buffer
+    if (consumed < COMPACT_THRESHOLD || consumed < buffer.size() / 2)
+        return 0;
+
+    buffer.remove(0, consumed);
+    return consumed;
+}
+}
+}
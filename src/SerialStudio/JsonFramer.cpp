@@ -0,0 +1,238 @@
+/*
+ * Copyright (c) 2022 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <SerialStudio/JsonFramer.h>
+
+#include <QJsonObject>
+#include <QJsonDocument>
+
+#include <Misc/StreamBuffer.h>
+
+/*
+ * Name of the key that contains the base64-encoded data sent by Serial Studio
+ */
+static constexpr QByteArrayView DATA_KEY("data");
+
+/*
+ * Incomplete objects are dropped if they grow beyond this size
+ */
+static constexpr qsizetype MAX_OBJECT_SIZE = 4 * 1024 * 1024;
+
+/**
+ * Constructor function
+ */
+SerialStudio::JsonFramer::JsonFramer()
+{
+    clear();
+}
+
+/**
+ * Discards all buffered data & resets the state of the framer
+ */
+void SerialStudio::JsonFramer::clear()
+{
+    m_buffer.clear();
+    m_scanPos = 0;
+    m_objectStart = -1;
+    m_stringStart = -1;
+    m_valueStart = -1;
+    m_valueEnd = -1;
+
+    m_depth = 0;
+    m_isKey = false;
+    m_escape = false;
+    m_dataKey = false;
+    m_inString = false;
+    m_expectKey = false;
+    m_valueEscaped = false;
+}
+
+/**
+ * Adds the given @a data to the framer buffer
+ */
+void SerialStudio::JsonFramer::append(QByteArrayView data)
+{
+    // Discard consumed data from time to time, but keep the current object
+    const auto consumed = m_objectStart >= 0 ? m_objectStart : m_scanPos;
+    const auto removed = Misc::StreamBuffer::compact(m_buffer, consumed);
+    m_scanPos -= removed;
+    if (m_objectStart >= 0)
+    {
+        m_objectStart -= removed;
+        m_stringStart -= removed;
+        m_valueStart -= removed;
+        m_valueEnd -= removed;
+    }
+
+    // Drop incomplete object if it grows too much (e.g. unbalanced braces)
+    if (m_objectStart >= 0 && m_buffer.size() - m_objectStart > MAX_OBJECT_SIZE)
+        clear();
+
+    // Add data to buffer
+    m_buffer.append(data.data(), data.size());
+}
+
+/**
+ * Scans the buffer from the position where the previous call stopped until a
+ * complete JSON object with a @c data value is found.
+ *
+ * If such object is found, the decoded contents of its @c data value are written to
+ * @a payload and @c true is returned. Otherwise, the framer keeps its current state
+ * so that the object is completed when more data is appended.
+ */
+bool SerialStudio::JsonFramer::next(QByteArray &payload)
+{
+    const auto data = m_buffer.constData();
+    const auto size = m_buffer.size();
+    while (m_scanPos < size)
+    {
+        const auto pos = m_scanPos++;
+        const auto c = data[pos];
+
+        // Inside a string, only look for escape sequences & the closing quote
+        if (m_inString)
+        {
+            if (m_escape)
+            {
+                m_escape = false;
+                if (m_depth == 1 && !m_isKey && m_dataKey)
+                    m_valueEscaped = true;
+            }
+
+            else if (c == '\\')
+                m_escape = true;
+
+            else if (c == '"')
+            {
+                m_inString = false;
+                if (m_depth == 1 && m_isKey)
+                {
+                    const auto key = QByteArrayView(data + m_stringStart,
+                                                    pos - m_stringStart);
+                    m_dataKey = (key == DATA_KEY);
+                    m_expectKey = false;
+                }
+
+                else if (m_depth == 1 && m_dataKey)
+                {
+                    m_valueStart = m_stringStart;
+                    m_valueEnd = pos;
+                }
+            }
+
+            continue;
+        }
+
+        // Outside of an object, discard everything until an object begins
+        if (m_objectStart < 0)
+        {
+            if (c == '{')
+                beginObject(pos);
+
+            continue;
+        }
+
+        // Track structure of the current object
+        switch (c)
+        {
+            case '"':
+                m_inString = true;
+                m_stringStart = pos + 1;
+                m_isKey = (m_depth == 1 && m_expectKey);
+                break;
+            case '{':
+            case '[':
+                ++m_depth;
+                break;
+            case ',':
+                if (m_depth == 1)
+                {
+                    m_expectKey = true;
+                    m_dataKey = false;
+                }
+                break;
+            case '}':
+            case ']':
+                if (--m_depth == 0)
+                {
+                    const auto found = extractPayload(payload);
+                    m_objectStart = -1;
+                    if (found)
+                        return true;
+                }
+                break;
+            default:
+                break;
+        }
+    }
+
+    return false;
+}
+
+/**
+ * Resets the object state when an object starts at the given @a position
+ */
+void SerialStudio::JsonFramer::beginObject(const qsizetype position)
+{
+    m_depth = 1;
+    m_objectStart = position;
+    m_stringStart = position;
+    m_valueStart = position;
+    m_valueEnd = position;
+
+    m_dataKey = false;
+    m_expectKey = true;
+    m_valueEscaped = false;
+}
+
+/**
+ * Decodes the @c data value of the object that has just been completed, returns
+ * @c false if the object has no string value for the @c data key.
+ */
+bool SerialStudio::JsonFramer::extractPayload(QByteArray &payload) const
+{
+    // Object does not contain a data value
+    if (m_valueEnd <= m_objectStart)
+        return false;
+
+    // Value contains escape sequences, let Qt handle them
+    if (m_valueEscaped)
+    {
+        const auto length = m_scanPos - m_objectStart;
+        const auto object = QByteArray::fromRawData(m_buffer.constData() + m_objectStart,
+                                                    length);
+        const auto document = QJsonDocument::fromJson(object);
+        const auto value = document.object().value(QLatin1String("data"));
+        if (!value.isString())
+            return false;
+
+        payload = QByteArray::fromBase64(value.toString().toUtf8());
+        return true;
+    }
+
+    // Decode base64 data directly from the buffer
+    const auto length = m_valueEnd - m_valueStart;
+    const auto base64 = QByteArray::fromRawData(m_buffer.constData() + m_valueStart,
+                                                length);
+    payload = QByteArray::fromBase64(base64);
+    return true;
+}
@@ -0,0 +1,71 @@
+/*
+ * Copyright (c) 2022 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#pragma once
+
+#include <QByteArray>
+#include <QByteArrayView>
+
+namespace SerialStudio
+{
+/**
+ * @brief The JsonFramer class
+ *
+ * Splits the JSON stream sent by Serial Studio into individual objects and extracts
+ * the base64-encoded @c data value of each one of them.
+ *
+ * The framer tracks brace depth & string state incrementally, so that objects split
+ * across several reads are completed when the rest of the data arrives, and every
+ * object of a read that contains several of them is processed. The @c data value is
+ * located while scanning, no @c QJsonDocument is built unless the value contains
+ * escape sequences.
+ */
+class JsonFramer
+{
+public:
+    JsonFramer();
+
+    void clear();
+    void append(QByteArrayView data);
+    bool next(QByteArray &payload);
+
+private:
+    void beginObject(const qsizetype position);
+    bool extractPayload(QByteArray &payload) const;
+
+private:
+    QByteArray m_buffer;
+    qsizetype m_scanPos;
+    qsizetype m_objectStart;
+    qsizetype m_stringStart;
+    qsizetype m_valueStart;
+    qsizetype m_valueEnd;
+
+    int m_depth;
+    bool m_isKey;
+    bool m_escape;
+    bool m_dataKey;
+    bool m_inString;
+    bool m_expectKey;
+    bool m_valueEscaped;
+};
+}
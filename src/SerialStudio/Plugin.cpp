@@ -23,28 +23,38 @@
 #include <SerialStudio/Plugin.h>
 
 #include <QTimer>
+#include <QThread>
 #include <QJsonArray>
 #include <QJsonObject>
 #include <QHostAddress>
 #include <QJsonDocument>
-#include <Misc/Utilities.h>
+#include <QSettings>
 #include <Misc/TimerEvents.h>
+#include <Misc/Notifications.h>
 
 /*
- * Set TCP port to communicate with Serial Studio
+ * Default TCP port to communicate with Serial Studio
  */
 #define SERIAL_STUDIO_PLUGINS_PORT 7777
 
 /**
- * Constructor function
+ * Constructor function, reads the TCP port of Serial Studio from the
+ * @c SerialStudio/Port setting
  */
 SerialStudio::Plugin::Plugin()
+    : m_socket(this)
+    , m_connected(false)
 {
+    // Get TCP port
+    const auto port = QSettings().value("SerialStudio/Port", SERIAL_STUDIO_PLUGINS_PORT);
+    setPort(port.toUInt() <= 0xFFFF ? port.toUInt() : 0);
+
     // Connect socket signals/slots
     connect(&m_socket, &QTcpSocket::readyRead, this, &Plugin::onDataReceived);
     connect(&m_socket, &QTcpSocket::disconnected, &m_socket, &QTcpSocket::close);
     connect(&m_socket, &QTcpSocket::connected, this, &Plugin::onConnectedChanged);
     connect(&m_socket, &QTcpSocket::disconnected, this, &Plugin::onConnectedChanged);
+    connect(&m_socket, &QTcpSocket::errorOccurred, this, &Plugin::onErrorOccurred);
 
     // Timer module signals/slots
     auto te = &(Misc::TimerEvents::instance());
@@ -61,19 +71,47 @@ SerialStudio::Plugin &SerialStudio::Plugin::instance()
 }
 
 /**
- * Returns @c true if the application is connected to the Serial Studio TCP server
+ * Returns @c true if the application is connected to the Serial Studio TCP server.
+ * This function can be called from any thread.
  */
 bool SerialStudio::Plugin::isConnected() const
 {
-    return m_socket.state() == QTcpSocket::ConnectedState;
+    return m_connected.load(std::memory_order_acquire);
+}
+
+/**
+ * Returns the TCP port of the Serial Studio plugin server
+ */
+quint16 SerialStudio::Plugin::port() const
+{
+    return m_port.load(std::memory_order_relaxed);
+}
+
+/**
+ * Changes the TCP port of the Serial Studio plugin server, invalid ports are replaced
+ * by the default port. The new port is used by the next connection attempt.
+ */
+void SerialStudio::Plugin::setPort(const quint16 port)
+{
+    m_port.store(port > 0 ? port : SERIAL_STUDIO_PLUGINS_PORT, std::memory_order_relaxed);
 }
 
 /**
  * Sends the given @a data string to Serial Studio, which in turn sends the data through
  * the serial port.
+ *
+ * If called from a thread other than the one that owns the socket, the data is queued
+ * for transmission and @c true is returned if the socket is connected.
  */
 bool SerialStudio::Plugin::write(const QByteArray &data)
 {
+    if (QThread::currentThread() != thread())
+    {
+        QMetaObject::invokeMethod(
+            this, [=]() { m_socket.write(data); }, Qt::QueuedConnection);
+        return isConnected();
+    }
+
     return m_socket.write(data) == data.length();
 }
 
@@ -85,7 +123,7 @@ void SerialStudio::Plugin::tryConnection()
     if (!isConnected())
     {
         m_socket.abort();
-        m_socket.connectToHost(QHostAddress::LocalHost, SERIAL_STUDIO_PLUGINS_PORT);
+        m_socket.connectToHost(QHostAddress::LocalHost, port());
     }
 }
 
@@ -94,26 +132,26 @@ void SerialStudio::Plugin::tryConnection()
  */
 void SerialStudio::Plugin::onDataReceived()
 {
-    auto recv = m_socket.readAll();
-    auto json = QJsonDocument::fromJson(recv);
+    m_framer.append(m_socket.readAll());
 
-    if (!json.isEmpty())
-    {
-        auto base64 = json.object().value("data").toString();
-        auto data = QByteArray::fromBase64(base64.toUtf8());
+    QByteArray data;
+    while (m_framer.next(data))
         Q_EMIT dataReceived(data);
-    }
 }
 
 /**
- * Waits 500 ms and notifies the UI if the TCP connection with Serial Studio has been
- * established.
+ * Waits 500 ms and notifies the control panel (which updates the UI) if the TCP
+ * connection with Serial Studio has been established.
  *
  * We need to wait in order to avoid 'flickering' in the UI when the plugin system of
  * Serial Studio is disabled.
  */
 void SerialStudio::Plugin::onConnectedChanged()
 {
+    m_framer.clear();
+    m_connected.store(m_socket.state() == QTcpSocket::ConnectedState,
+                      std::memory_order_release);
+
     if (isConnected())
         Q_EMIT printLn("[INFO] TCP connection established");
     else
@@ -123,11 +161,15 @@ void SerialStudio::Plugin::onConnectedChanged()
 }
 
 /**
- * Displays any socket errors with a message-box
+ * Displays any socket errors with a non-modal notification. Refused connections are
+ * ignored, since they only mean that Serial Studio is not running yet.
  */
 void SerialStudio::Plugin::onErrorOccurred(const QAbstractSocket::SocketError socketError)
 {
-    Q_UNUSED(socketError);
+    if (socketError == QAbstractSocket::ConnectionRefusedError)
+        return;
+
     Q_EMIT printLn("[WARN] TCP socket error: " + m_socket.errorString());
-    Misc::Utilities::showMessageBox(tr("TCP socket error"), m_socket.errorString());
+    Misc::Notifications::instance().post(Misc::Notifications::Warning,
+                                         tr("TCP socket error"), m_socket.errorString());
 }
@@ -25,16 +25,15 @@
 #include <QObject>
 #include <QTcpSocket>
 
+#include <atomic>
+
+#include <SerialStudio/JsonFramer.h>
+
 namespace SerialStudio
 {
 class Plugin : public QObject
 {
-    // clang-format off
     Q_OBJECT
-    Q_PROPERTY(bool isConnected
-               READ isConnected
-               NOTIFY connectedChanged)
-    // clang-format on
 
 Q_SIGNALS:
     void connectedChanged();
@@ -52,7 +51,9 @@ public:
     static Plugin &instance();
 
 public:
+    quint16 port() const;
     bool isConnected() const;
+    void setPort(const quint16 port);
     bool write(const QByteArray &data);
 
 public slots:
@@ -65,5 +66,8 @@ private slots:
 
 private:
     QTcpSocket m_socket;
+    JsonFramer m_framer;
+    std::atomic<bool> m_connected;
+    std::atomic<quint16> m_port;
 };
 };
@@ -0,0 +1,253 @@
+/*
+ * Copyright (c) 2022 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "FrameBuilder.h"
+#include "FrameDecoder.h"
+
+#include <QSettings>
+#include <QtEndian>
+
+#include <cstring>
+
+/*
+ * Default destination of the transmitted frames (the XBee of the CanSat container)
+ */
+static constexpr quint64 DEFAULT_ADDRESS_64 = 0x0013A2004183A626;
+static constexpr quint16 DEFAULT_ADDRESS_16 = 0xFFFE;
+
+/*
+ * API frame delimiter & transmit request frame type
+ */
+static constexpr char START_DELIMITER = 0x7E;
+static constexpr char TRANSMIT_REQUEST = XBee::TransmitRequest;
+
+/*
+ * Escape byte & value XOR-ed with the escaped bytes in API mode 2
+ */
+static constexpr quint8 ESCAPE = 0x7D;
+static constexpr quint8 ESCAPE_XOR = 0x20;
+
+/*
+ * Offsets of the frame fields: start delimiter, length (2 bytes), frame type, frame
+ * ID, 64-bit address (8 bytes), 16-bit address (2 bytes), radius & options
+ */
+static constexpr qsizetype LENGTH_OFFSET = 1;
+static constexpr qsizetype FRAME_DATA_OFFSET = 3;
+static constexpr qsizetype FRAME_ID_OFFSET = 4;
+static constexpr qsizetype HEADER_SIZE = 17;
+
+/*
+ * Initial capacity of the output buffer
+ */
+static constexpr qsizetype INITIAL_CAPACITY = 256;
+
+/**
+ * Constructor function, sets the default destination address
+ */
+XBee::FrameBuilder::FrameBuilder()
+    : m_escaped(false)
+    , m_encoder(QStringEncoder::Utf8, QStringConverter::Flag::Stateless)
+{
+    m_buffer.reserve(INITIAL_CAPACITY);
+    setDestination(DEFAULT_ADDRESS_64, DEFAULT_ADDRESS_16);
+}
+
+/**
+ * Returns the 64-bit destination address
+ */
+quint64 XBee::FrameBuilder::address64() const
+{
+    return m_address64;
+}
+
+/**
+ * Returns the 16-bit destination address
+ */
+quint16 XBee::FrameBuilder::address16() const
+{
+    return m_address16;
+}
+
+/**
+ * Returns @c true if the frames are escaped (API mode 2)
+ */
+bool XBee::FrameBuilder::escaped() const
+{
+    return m_escaped;
+}
+
+/**
+ * Enables or disables the escaping of the frames (API mode 2)
+ */
+void XBee::FrameBuilder::setEscaped(const bool escaped)
+{
+    m_escaped = escaped;
+}
+
+/**
+ * Reads the destination addresses from the @c XBee/Address64 & @c XBee/Address16
+ * settings (hexadecimal strings) and the API mode from @c XBee/ApiMode. Invalid
+ * addresses are replaced by the default addresses.
+ */
+void XBee::FrameBuilder::loadSettings()
+{
+    QSettings settings;
+    bool ok64, ok16;
+    const auto value64 = settings.value("XBee/Address64", "0013A2004183A626").toString();
+    const auto value16 = settings.value("XBee/Address16", "FFFE").toString();
+    auto address64 = value64.toULongLong(&ok64, 16);
+    auto address16 = value16.toUShort(&ok16, 16);
+
+    if (!ok64)
+        address64 = DEFAULT_ADDRESS_64;
+    if (!ok16)
+        address16 = DEFAULT_ADDRESS_16;
+
+    setDestination(address64, address16);
+
+    const auto mode = settings.value("XBee/ApiMode", 0).toInt();
+    setEscaped(mode == static_cast<int>(ApiMode::ApiEscaped));
+}
+
+/**
+ * Changes the destination of the frames, the constant frame header & its partial
+ * checksum are precomputed here.
+ */
+void XBee::FrameBuilder::setDestination(const quint64 address64, const quint16 address16)
+{
+    m_address64 = address64;
+    m_address16 = address16;
+
+    // Build frame header (length & frame ID are written for each frame)
+    m_header = QByteArray(HEADER_SIZE, '\0');
+    auto header = m_header.data();
+    header[0] = START_DELIMITER;
+    header[FRAME_DATA_OFFSET] = TRANSMIT_REQUEST;
+    qToBigEndian<quint64>(address64, header + 5);
+    qToBigEndian<quint16>(address16, header + 13);
+
+    // Sum the constant bytes of the frame data
+    m_headerSum = 0;
+    for (auto i = FRAME_DATA_OFFSET; i < HEADER_SIZE; ++i)
+        m_headerSum += static_cast<quint8>(header[i]);
+}
+
+/**
+ * Builds a transmit request frame with the given @a frameId that carries the given
+ * @a payload bytes
+ */
+const QByteArray &XBee::FrameBuilder::build(const quint8 frameId, QByteArrayView payload)
+{
+    auto out = beginFrame(payload.size());
+    std::memcpy(out, payload.data(), payload.size());
+    return finishFrame(frameId, payload.size());
+}
+
+/**
+ * Builds a transmit request frame with the given @a frameId, the @a payload text is
+ * encoded to UTF-8 directly into the output buffer
+ */
+const QByteArray &XBee::FrameBuilder::build(const quint8 frameId, QStringView payload)
+{
+    auto out = beginFrame(m_encoder.requiredSpace(payload.size()));
+    const auto end = m_encoder.appendToBuffer(out, payload);
+    return finishFrame(frameId, end - out);
+}
+
+/**
+ * Copies the frame header to the output buffer & makes room for up to
+ * @a maxPayloadSize payload bytes, returns a pointer to the payload area
+ */
+char *XBee::FrameBuilder::beginFrame(const qsizetype maxPayloadSize)
+{
+    m_buffer.resize(HEADER_SIZE + maxPayloadSize + 1);
+    std::memcpy(m_buffer.data(), m_header.constData(), HEADER_SIZE);
+    return m_buffer.data() + HEADER_SIZE;
+}
+
+/**
+ * Writes the frame ID, frame length & checksum of a frame that carries
+ * @a payloadSize payload bytes
+ */
+const QByteArray &XBee::FrameBuilder::finishFrame(const quint8 frameId,
+                                                  const qsizetype payloadSize)
+{
+    auto frame = m_buffer.data();
+    const auto length = HEADER_SIZE - FRAME_DATA_OFFSET + payloadSize;
+
+    // Write frame ID & length
+    frame[FRAME_ID_OFFSET] = static_cast<char>(frameId);
+    qToBigEndian<quint16>(static_cast<quint16>(length), frame + LENGTH_OFFSET);
+
+    // Finish checksum over the frame ID & payload
+    quint8 sum = m_headerSum + frameId;
+    const auto payload = reinterpret_cast<const quint8 *>(frame + HEADER_SIZE);
+    for (qsizetype i = 0; i < payloadSize; ++i)
+        sum += payload[i];
+
+    // Write checksum & remove unused bytes
+    frame[HEADER_SIZE + payloadSize] = static_cast<char>(0xFF - sum);
+    m_buffer.resize(HEADER_SIZE + payloadSize + 1);
+
+    // Escape frame if required
+    if (m_escaped)
+        escapeFrame();
+
+    return m_buffer;
+}
+
+/**
+ * Escapes the special bytes of the frame in the output buffer, the frame is expanded
+ * in place from its end so that every byte is moved only once
+ */
+void XBee::FrameBuilder::escapeFrame()
+{
+    const auto needsEscape = [](const quint8 byte) {
+        return byte == 0x7E || byte == ESCAPE || byte == 0x11 || byte == 0x13;
+    };
+
+    // Count the bytes that must be escaped (the start delimiter is never escaped)
+    qsizetype count = 0;
+    const auto size = m_buffer.size();
+    for (qsizetype i = 1; i < size; ++i)
+        count += needsEscape(static_cast<quint8>(m_buffer.at(i)));
+
+    // Nothing to do
+    if (count == 0)
+        return;
+
+    // Expand the frame from its end
+    m_buffer.resize(size + count);
+    auto data = m_buffer.data();
+    auto out = size + count;
+    for (auto i = size - 1; i > 0 && out > i + 1; --i)
+    {
+        const auto byte = static_cast<quint8>(data[i]);
+        if (needsEscape(byte))
+        {
+            data[--out] = static_cast<char>(byte ^ ESCAPE_XOR);
+            data[--out] = static_cast<char>(ESCAPE);
+        }
+        else
+            data[--out] = static_cast<char>(byte);
+    }
+}
@@ -0,0 +1,78 @@
+/*
+ * Copyright (c) 2022 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#pragma once
+
+#include <QByteArray>
+#include <QStringView>
+#include <QStringEncoder>
+
+namespace XBee
+{
+/**
+ * @brief The FrameBuilder class
+ *
+ * Builds XBee API transmit request (0x10) frames for a single destination. The
+ * constant part of the frame (API identifier, 64-bit & 16-bit destination addresses,
+ * broadcast radius & options) and its partial checksum are computed once, when the
+ * destination is set. Building a frame only writes the frame ID & the payload into a
+ * preallocated output buffer and finishes the checksum over the payload bytes.
+ *
+ * In escaped mode (API mode 2), the bytes that follow the start delimiter are escaped
+ * in place once the frame is complete.
+ *
+ * The returned frame shares its data with the internal buffer, so building a frame
+ * does not allocate memory unless a previously returned frame is still referenced.
+ */
+class FrameBuilder
+{
+public:
+    FrameBuilder();
+
+    quint64 address64() const;
+    quint16 address16() const;
+
+    bool escaped() const;
+    void setEscaped(const bool escaped);
+
+    void loadSettings();
+    void setDestination(const quint64 address64, const quint16 address16);
+
+    const QByteArray &build(const quint8 frameId, QByteArrayView payload);
+    const QByteArray &build(const quint8 frameId, QStringView payload);
+
+private:
+    char *beginFrame(const qsizetype maxPayloadSize);
+    const QByteArray &finishFrame(const quint8 frameId, const qsizetype payloadSize);
+    void escapeFrame();
+
+private:
+    quint64 m_address64;
+    quint16 m_address16;
+    bool m_escaped;
+    quint8 m_headerSum;
+
+    QByteArray m_header;
+    QByteArray m_buffer;
+    QStringEncoder m_encoder;
+};
+}
@@ -0,0 +1,240 @@
+/*
+ * Copyright (c) 2022 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "FrameDecoder.h"
+
+#include <cstring>
+
+#include <Misc/StreamBuffer.h>
+
+/*
+ * Special bytes of the XBee API protocol
+ */
+static constexpr quint8 START_DELIMITER = 0x7E;
+static constexpr quint8 ESCAPE = 0x7D;
+static constexpr quint8 ESCAPE_XOR = 0x20;
+
+/*
+ * Frames longer than this are considered to be invalid
+ */
+static constexpr quint16 MAX_FRAME_LENGTH = 2048;
+
+/**
+ * Constructor function
+ */
+XBee::FrameDecoder::FrameDecoder()
+    : m_state(State::Delimiter)
+    , m_escaped(false)
+    , m_escapeNext(false)
+    , m_checksum(0)
+    , m_length(0)
+    , m_readPos(0)
+    , m_writePos(0)
+    , m_frameStart(0)
+    , m_delimiterPos(0)
+    , m_invalidFrames(0)
+    , m_discardedBytes(0)
+{
+}
+
+/**
+ * Returns @c true if the decoder expects escaped frames (API mode 2)
+ */
+bool XBee::FrameDecoder::escaped() const
+{
+    return m_escaped;
+}
+
+/**
+ * Enables or disables the processing of escape bytes (API mode 2)
+ */
+void XBee::FrameDecoder::setEscaped(const bool escaped)
+{
+    m_escaped = escaped;
+    clear();
+}
+
+/**
+ * Returns the number of frames rejected because of their length or checksum
+ */
+quint64 XBee::FrameDecoder::invalidFrames() const
+{
+    return m_invalidFrames;
+}
+
+/**
+ * Returns the number of received bytes that were not part of any frame
+ */
+quint64 XBee::FrameDecoder::discardedBytes() const
+{
+    return m_discardedBytes;
+}
+
+/**
+ * Discards all buffered data & resets the state of the decoder
+ */
+void XBee::FrameDecoder::clear()
+{
+    m_buffer.clear();
+    m_state = State::Delimiter;
+    m_escapeNext = false;
+    m_readPos = 0;
+    m_writePos = 0;
+    m_frameStart = 0;
+    m_delimiterPos = 0;
+}
+
+/**
+ * Adds the given @a data to the decoder buffer.
+ *
+ * Any frame view obtained with @c next() before calling this function becomes
+ * invalid.
+ */
+void XBee::FrameDecoder::append(QByteArrayView data)
+{
+    // Discard consumed data, but keep the current frame (from its delimiter)
+    const auto consumed = m_state == State::Delimiter ? m_readPos : m_delimiterPos;
+    const auto removed = Misc::StreamBuffer::compact(m_buffer, consumed);
+    m_readPos -= removed;
+    m_writePos -= removed;
+    m_frameStart -= removed;
+    m_delimiterPos -= removed;
+
+    // Add data to buffer
+    m_buffer.append(data.data(), data.size());
+}
+
+/**
+ * Decodes buffered data until a complete & valid frame is found. If so, @a frame is
+ * set to a view of the unescaped frame data (API identifier followed by the frame
+ * specific data) and @c true is returned.
+ */
+bool XBee::FrameDecoder::next(QByteArrayView &frame)
+{
+    auto data = reinterpret_cast<quint8 *>(m_buffer.data());
+    const auto size = m_buffer.size();
+
+    while (m_readPos < size)
+    {
+        // Skip everything until the next start delimiter
+        if (m_state == State::Delimiter)
+        {
+            const auto rem = static_cast<std::size_t>(size - m_readPos);
+            const auto ptr = std::memchr(data + m_readPos, START_DELIMITER, rem);
+            if (!ptr)
+            {
+                m_discardedBytes += size - m_readPos;
+                m_readPos = size;
+                return false;
+            }
+
+            const auto index = static_cast<const quint8 *>(ptr) - data;
+            m_discardedBytes += index - m_readPos;
+            m_delimiterPos = index;
+            m_readPos = index + 1;
+            m_escapeNext = false;
+            m_state = State::LengthHigh;
+            continue;
+        }
+
+        // Get next byte
+        auto byte = data[m_readPos++];
+
+        // Process escape sequences, a delimiter always starts a new frame
+        if (m_escaped)
+        {
+            if (byte == START_DELIMITER)
+            {
+                ++m_invalidFrames;
+                m_delimiterPos = m_readPos - 1;
+                m_escapeNext = false;
+                m_state = State::LengthHigh;
+                continue;
+            }
+
+            if (byte == ESCAPE)
+            {
+                m_escapeNext = true;
+                continue;
+            }
+
+            if (m_escapeNext)
+            {
+                byte ^= ESCAPE_XOR;
+                m_escapeNext = false;
+            }
+        }
+
+        // Update state machine
+        switch (m_state)
+        {
+            case State::LengthHigh:
+                m_length = static_cast<quint16>(byte << 8);
+                m_state = State::LengthLow;
+                break;
+            case State::LengthLow:
+                m_length |= byte;
+                if (m_length == 0 || m_length > MAX_FRAME_LENGTH)
+                    reject();
+                else
+                {
+                    m_checksum = 0;
+                    m_writePos = m_readPos;
+                    m_frameStart = m_readPos;
+                    m_state = State::FrameData;
+                }
+                break;
+            case State::FrameData:
+                data[m_writePos++] = byte;
+                m_checksum += byte;
+                if (m_writePos - m_frameStart == m_length)
+                    m_state = State::Checksum;
+                break;
+            case State::Checksum:
+                if (static_cast<quint8>(m_checksum + byte) != 0xFF)
+                    reject();
+                else
+                {
+                    m_state = State::Delimiter;
+                    frame = QByteArrayView(m_buffer.constData() + m_frameStart, m_length);
+                    return true;
+                }
+                break;
+            default:
+                break;
+        }
+    }
+
+    return false;
+}
+
+/**
+ * Discards the current frame & looks for the next start delimiter. In non-escaped
+ * mode, the search restarts right after the delimiter of the rejected frame.
+ */
+void XBee::FrameDecoder::reject()
+{
+    ++m_invalidFrames;
+    m_state = State::Delimiter;
+    if (!m_escaped)
+        m_readPos = m_delimiterPos + 1;
+}
@@ -0,0 +1,114 @@
+/*
+ * Copyright (c) 2022 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#pragma once
+
+#include <QByteArray>
+#include <QByteArrayView>
+
+namespace XBee
+{
+/**
+ * Operating modes of the XBee serial interface
+ */
+enum class ApiMode
+{
+    Transparent = 0,
+    Api = 1,
+    ApiEscaped = 2,
+};
+
+/**
+ * API frame types handled by the control panel
+ */
+enum FrameType : quint8
+{
+    TransmitRequest = 0x10,
+    TransmitStatus = 0x8B,
+    ReceivePacket = 0x90,
+};
+
+/**
+ * Size of the header of a receive packet (0x90) frame: frame type, 64-bit & 16-bit
+ * source addresses & receive options. The RF data follows the header.
+ */
+static constexpr qsizetype RECEIVE_PACKET_HEADER_SIZE = 12;
+
+/**
+ * @brief The FrameDecoder class
+ *
+ * Streaming decoder for XBee API frames (start delimiter, 16-bit length, frame data &
+ * checksum). Received data is processed one byte at a time by a state machine that
+ * survives arbitrary fragmentation, validates the length & checksum of every frame
+ * and, in escaped mode (API mode 2), removes the escape bytes in place.
+ *
+ * Bytes outside of frames and frames with invalid lengths or checksums are discarded
+ * and counted. In non-escaped mode, the decoder resynchronizes right after the
+ * delimiter of a rejected frame, so that a stray 0x7E byte does not hide the frames
+ * that follow it.
+ *
+ * @note Frame views are valid until the next call to @c append() or @c clear().
+ */
+class FrameDecoder
+{
+public:
+    FrameDecoder();
+
+    bool escaped() const;
+    void setEscaped(const bool escaped);
+
+    quint64 invalidFrames() const;
+    quint64 discardedBytes() const;
+
+    void clear();
+    void append(QByteArrayView data);
+    bool next(QByteArrayView &frame);
+
+private:
+    void reject();
+
+private:
+    enum class State
+    {
+        Delimiter,
+        LengthHigh,
+        LengthLow,
+        FrameData,
+        Checksum,
+    };
+
+    State m_state;
+    bool m_escaped;
+    bool m_escapeNext;
+    quint8 m_checksum;
+    quint16 m_length;
+
+    QByteArray m_buffer;
+    qsizetype m_readPos;
+    qsizetype m_writePos;
+    qsizetype m_frameStart;
+    qsizetype m_delimiterPos;
+
+    quint64 m_invalidFrames;
+    quint64 m_discardedBytes;
+};
+}
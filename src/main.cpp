@@ -25,18 +25,113 @@
 #include <QQuickStyle>
 #include <QApplication>
 #include <QStyleFactory>
+#include <QCoreApplication>
+#include <QCommandLineParser>
 #include <QQmlApplicationEngine>
 
 #include <AppInfo.h>
+#include <Misc/Console.h>
 #include <Misc/Utilities.h>
 #include <Misc/TimerEvents.h>
+#include <Misc/Notifications.h>
 #include <CanSat/ControlPanel.h>
 #include <SerialStudio/Plugin.h>
+#include <CanSat/IngestionWorker.h>
+#include <CanSat/HeadlessController.h>
 
 #ifdef Q_OS_WIN
 #    include <windows.h>
 #endif
 
+/**
+ * Shows the messages of the control panel & Serial Studio modules in the console
+ */
+static void connectConsole()
+{
+    auto console = &Misc::Console::instance();
+    auto plugin = &SerialStudio::Plugin::instance();
+    auto controlPanel = &CanSat::ControlPanel::instance();
+
+    QObject::connect(controlPanel, &CanSat::ControlPanel::printLn, console,
+                     [=](const QString &line) {
+                         console->append(" [Control Panel] " + line);
+                     });
+    QObject::connect(plugin, &SerialStudio::Plugin::printLn, console,
+                     [=](const QString &line) {
+                         console->append(" [Serial Studio] " + line);
+                     });
+}
+
+/**
+ * Starts the ingestion thread (stopping it before the application quits) & the timer
+ * subsystem
+ */
+static void startPipeline()
+{
+    auto ingestion = &CanSat::IngestionWorker::instance();
+    ingestion->start();
+    QObject::connect(qApp, &QCoreApplication::aboutToQuit, ingestion,
+                     &CanSat::IngestionWorker::stop, Qt::DirectConnection);
+
+    Misc::TimerEvents::instance().startTimers();
+}
+
+/**
+ * Returns @c true if the application was started with the @c --headless option. This
+ * is checked before creating the application object, since it decides which one to
+ * create.
+ */
+static bool headlessRequested(int argc, char **argv)
+{
+    for (int i = 1; i < argc; ++i)
+    {
+        if (qstrcmp(argv[i], "--headless") == 0)
+            return true;
+    }
+
+    return false;
+}
+
+/**
+ * Runs the ground station without user interface: telemetry is received, logged &
+ * printed to the standard output, and commands are read from the standard input or
+ * the local control socket. Only a @c QCoreApplication is created, so that the GUI &
+ * QML modules are never initialized.
+ *
+ * @param argc argument count
+ * @param argv argument data
+ *
+ * @return qApp exit code
+ */
+static int runHeadless(int argc, char **argv)
+{
+    // Init. application
+    QCoreApplication app(argc, argv);
+    app.setApplicationName(APP_NAME);
+    app.setApplicationVersion(APP_VERSION);
+    app.setOrganizationName(APP_DEVELOPER);
+
+    // Parse command line options
+    QCommandLineParser parser;
+    parser.addHelpOption();
+    parser.addVersionOption();
+    parser.setApplicationDescription("CanSat ground station (headless mode)");
+    parser.addOption({ "headless", "Run without user interface." });
+    parser.addOption({ "socket", "Name of the local control socket.", "name" });
+    parser.process(app);
+
+    // Init application modules & print module messages
+    connectConsole();
+    auto controller = &CanSat::HeadlessController::instance();
+    controller->start(parser.value("socket"));
+
+    // Start telemetry pipeline
+    startPipeline();
+
+    // Enter application event loop
+    return app.exec();
+}
+
 /**
  * @brief Entry-point function of the application
  *
@@ -61,6 +156,10 @@ int main(int argc, char **argv)
     }
 #endif
 
+    // Run without user interface
+    if (headlessRequested(argc, argv))
+        return runHeadless(argc, argv);
+
     // Init. application
     QApplication app(argc, argv);
     app.setApplicationName(APP_NAME);
@@ -69,18 +168,23 @@ int main(int argc, char **argv)
 
     // Init application modules
     QQmlApplicationEngine engine;
+    auto console = &Misc::Console::instance();
     auto utilities = &Misc::Utilities::instance();
     auto timerEvents = &Misc::TimerEvents::instance();
-    auto plugin = &SerialStudio::Plugin::instance();
+    auto notifications = &Misc::Notifications::instance();
     auto controlPanel = &CanSat::ControlPanel::instance();
 
+    // Show module messages in the console
+    connectConsole();
+
     // Init QML interface
     auto c = engine.rootContext();
     QQuickStyle::setStyle("Material");
     c->setContextProperty("Cpp_AppIcon", "qrc" APP_ICON);
+    c->setContextProperty("Cpp_Misc_Console", console);
     c->setContextProperty("Cpp_Misc_Utilities", utilities);
-    c->setContextProperty("Cpp_SerialStudio_Plugin", plugin);
     c->setContextProperty("Cpp_Misc_TimerEvents", timerEvents);
+    c->setContextProperty("Cpp_Misc_Notifications", notifications);
     c->setContextProperty("Cpp_AppName", app.applicationName());
     c->setContextProperty("Cpp_CanSat_ControlPanel", controlPanel);
     c->setContextProperty("Cpp_AppVersion", app.applicationVersion());
@@ -92,8 +196,8 @@ int main(int argc, char **argv)
     if (engine.rootObjects().isEmpty())
         return EXIT_FAILURE;
 
-    // Start timer subsystem
-    Misc::TimerEvents::instance().startTimers();
+    // Start telemetry pipeline
+    startPipeline();
 
     // Enter application event loop
     return app.exec();
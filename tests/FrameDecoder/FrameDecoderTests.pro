@@ -0,0 +1,34 @@
+#-------------------------------------------------------------------------------
+# Make options
+#-------------------------------------------------------------------------------
+
+MOC_DIR = moc
+OBJECTS_DIR = obj
+
+CONFIG += c++17
+CONFIG += console testcase
+CONFIG -= app_bundle
+
+#-------------------------------------------------------------------------------
+# Qt configuration
+#-------------------------------------------------------------------------------
+
+TEMPLATE = app
+TARGET = FrameDecoderTests
+
+QT = core testlib
+
+#-------------------------------------------------------------------------------
+# Import source code
+#-------------------------------------------------------------------------------
+
+INCLUDEPATH += $$PWD/../../src
+
+HEADERS += \
+    testframedecoder.h \
+    ../../src/Misc/StreamBuffer.h \
+    ../../src/XBee/FrameDecoder.h
+
+SOURCES += \
+    testframedecoder.cpp \
+    ../../src/XBee/FrameDecoder.cpp
@@ -0,0 +1,347 @@
+/*
+ * Copyright (c) 2022 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "testframedecoder.h"
+
+#include <QtTest>
+#include <QList>
+#include <QtEndian>
+
+#include <XBee/FrameDecoder.h>
+
+/*
+ * Frame data used by most tests (receive packet & transmit status frames)
+ */
+static const QByteArray RECEIVE_DATA = QByteArray("\x90") + "1099,12:00:00,1,F";
+static const QByteArray STATUS_DATA = QByteArrayLiteral("\x8B\x01\xFF\xFE\x00\x00\x00");
+
+/*
+ * Decodes every complete frame in the buffer of the @a decoder
+ */
+static QList<QByteArray> decodeAll(XBee::FrameDecoder &decoder)
+{
+    QList<QByteArray> frames;
+    QByteArrayView frame;
+    while (decoder.next(frame))
+        frames.append(frame.toByteArray());
+
+    return frames;
+}
+
+/**
+ * Decodes consecutive frames received in a single piece
+ */
+void TestFrameDecoder::testValidFrames()
+{
+    XBee::FrameDecoder decoder;
+    decoder.append(apiFrame(RECEIVE_DATA) + apiFrame(STATUS_DATA));
+
+    const auto frames = decodeAll(decoder);
+    QCOMPARE(frames.size(), 2);
+    QCOMPARE(frames[0], RECEIVE_DATA);
+    QCOMPARE(frames[1], STATUS_DATA);
+    QCOMPARE(decoder.invalidFrames(), quint64(0));
+    QCOMPARE(decoder.discardedBytes(), quint64(0));
+}
+
+/**
+ * Decodes frames that are received one byte at a time
+ */
+void TestFrameDecoder::testFragmentation()
+{
+    for (const auto escaped : {false, true})
+    {
+        XBee::FrameDecoder decoder;
+        decoder.setEscaped(escaped);
+
+        QList<QByteArray> frames;
+        const auto data = apiFrame(RECEIVE_DATA, escaped)
+                        + apiFrame(STATUS_DATA, escaped);
+        for (const auto byte : data)
+        {
+            decoder.append(QByteArrayView(&byte, 1));
+            frames.append(decodeAll(decoder));
+        }
+
+        QCOMPARE(frames.size(), 2);
+        QCOMPARE(frames[0], RECEIVE_DATA);
+        QCOMPARE(frames[1], STATUS_DATA);
+        QCOMPARE(decoder.invalidFrames(), quint64(0));
+    }
+}
+
+/**
+ * Rejects a frame with an invalid checksum & decodes the frame that follows it
+ */
+void TestFrameDecoder::testChecksum()
+{
+    auto corrupted = apiFrame(RECEIVE_DATA);
+    corrupted[corrupted.size() - 1] = char(corrupted.back() ^ 0x01);
+
+    XBee::FrameDecoder decoder;
+    decoder.append(corrupted + apiFrame(STATUS_DATA));
+
+    const auto frames = decodeAll(decoder);
+    QCOMPARE(frames.size(), 1);
+    QCOMPARE(frames[0], STATUS_DATA);
+    QCOMPARE(decoder.invalidFrames(), quint64(1));
+}
+
+/**
+ * Rejects frames with a zero length or a length above the maximum frame size
+ */
+void TestFrameDecoder::testLength()
+{
+    const auto empty = QByteArrayLiteral("\x7E\x00\x00\xFF");
+    const auto oversized = QByteArrayLiteral("\x7E\x10\x00");
+
+    XBee::FrameDecoder decoder;
+    decoder.append(empty + oversized + apiFrame(STATUS_DATA));
+
+    const auto frames = decodeAll(decoder);
+    QCOMPARE(frames.size(), 1);
+    QCOMPARE(frames[0], STATUS_DATA);
+    QCOMPARE(decoder.invalidFrames(), quint64(2));
+
+    // Bytes that followed the rejected delimiters
+    QCOMPARE(decoder.discardedBytes(), quint64(5));
+}
+
+/**
+ * Removes the escape bytes (0x7D) of API mode 2 frames, including the escaped length
+ * & checksum bytes
+ */
+void TestFrameDecoder::testEscaping()
+{
+    const auto special = QByteArrayLiteral("\x90\x7E\x7D\x11\x13\x7E\x7D");
+
+    // Frame data with special bytes
+    XBee::FrameDecoder decoder;
+    decoder.setEscaped(true);
+    const auto frame = apiFrame(special, true);
+    QVERIFY(frame.count(char(0x7D)) >= 6);
+    decoder.append(frame);
+
+    auto frames = decodeAll(decoder);
+    QCOMPARE(frames.size(), 1);
+    QCOMPARE(frames[0], special);
+
+    // Lengths with special bytes
+    for (const auto length : {0x11, 0x13, 0x7D, 0x7E})
+    {
+        const auto data = QByteArray("\x90") + QByteArray(length - 1, 'A');
+        decoder.append(apiFrame(data, true));
+
+        frames = decodeAll(decoder);
+        QCOMPARE(frames.size(), 1);
+        QCOMPARE(frames[0], data);
+    }
+
+    QCOMPARE(decoder.invalidFrames(), quint64(0));
+
+    // Special bytes are not escaped in API mode 1
+    XBee::FrameDecoder plain;
+    plain.append(apiFrame(special));
+    frames = decodeAll(plain);
+    QCOMPARE(frames.size(), 1);
+    QCOMPARE(frames[0], special);
+}
+
+/**
+ * In API mode 2, a start delimiter inside a frame always starts a new frame
+ */
+void TestFrameDecoder::testDelimiterInEscapedFrame()
+{
+    const auto truncated = apiFrame(RECEIVE_DATA, true).left(8);
+
+    XBee::FrameDecoder decoder;
+    decoder.setEscaped(true);
+    decoder.append(truncated + apiFrame(STATUS_DATA, true));
+
+    const auto frames = decodeAll(decoder);
+    QCOMPARE(frames.size(), 1);
+    QCOMPARE(frames[0], STATUS_DATA);
+    QCOMPARE(decoder.invalidFrames(), quint64(1));
+}
+
+/**
+ * In API mode 1, the search for the next frame restarts right after the delimiter of
+ * a rejected frame, so that a stray 0x7E byte does not hide the frame that follows
+ */
+void TestFrameDecoder::testResyncAfterBadDelimiter()
+{
+    // Stray delimiter, the length is read from the next frame delimiter
+    XBee::FrameDecoder decoder;
+    decoder.append(QByteArrayLiteral("\x7E") + apiFrame(RECEIVE_DATA));
+
+    auto frames = decodeAll(decoder);
+    QCOMPARE(frames.size(), 1);
+    QCOMPARE(frames[0], RECEIVE_DATA);
+    QCOMPARE(decoder.invalidFrames(), quint64(1));
+
+    // Stray delimiter with a valid length, the next frame is read as its data
+    decoder.append(QByteArrayLiteral("\x7E\x00\x02") + apiFrame(STATUS_DATA));
+
+    frames = decodeAll(decoder);
+    QCOMPARE(frames.size(), 1);
+    QCOMPARE(frames[0], STATUS_DATA);
+    QCOMPARE(decoder.invalidFrames(), quint64(2));
+    QCOMPARE(decoder.discardedBytes(), quint64(2));
+}
+
+/**
+ * Counts the bytes that are received outside of frames
+ */
+void TestFrameDecoder::testDiscardedBytes()
+{
+    XBee::FrameDecoder decoder;
+    decoder.append("noise" + apiFrame(RECEIVE_DATA) + "tail");
+
+    const auto frames = decodeAll(decoder);
+    QCOMPARE(frames.size(), 1);
+    QCOMPARE(frames[0], RECEIVE_DATA);
+    QCOMPARE(decoder.invalidFrames(), quint64(0));
+    QCOMPARE(decoder.discardedBytes(), quint64(9));
+}
+
+/**
+ * Decodes several times the compaction threshold of frames, received in chunks that
+ * split frames, so that consumed data is removed while a frame is being received
+ */
+void TestFrameDecoder::testCompaction()
+{
+    static constexpr int FRAMES = 4000;
+    static constexpr int CHUNK_SIZE = 1000;
+
+    for (const auto escaped : {false, true})
+    {
+        QByteArray stream;
+        for (int i = 0; i < FRAMES; ++i)
+        {
+            auto data = RECEIVE_DATA + QByteArray::number(i);
+            data.append(QByteArray(i % 80, char(i)));
+            stream.append(apiFrame(data, escaped));
+        }
+
+        XBee::FrameDecoder decoder;
+        decoder.setEscaped(escaped);
+
+        int count = 0;
+        for (qsizetype i = 0; i < stream.size(); i += CHUNK_SIZE)
+        {
+            decoder.append(QByteArrayView(stream).sliced(
+                i, qMin<qsizetype>(CHUNK_SIZE, stream.size() - i)));
+
+            for (const auto &frame : decodeAll(decoder))
+            {
+                const auto number = RECEIVE_DATA + QByteArray::number(count);
+                QVERIFY(frame.startsWith(number));
+                QCOMPARE(frame.size(), number.size() + count % 80);
+                ++count;
+            }
+        }
+
+        QCOMPARE(count, FRAMES);
+        QCOMPARE(decoder.invalidFrames(), quint64(0));
+        QCOMPARE(decoder.discardedBytes(), quint64(0));
+    }
+}
+
+/**
+ * Decodes receive packets (0x90) of every telemetry size up to 512 bytes, so that the
+ * lengths & checksums that must be escaped in API mode 2 are covered
+ */
+void TestFrameDecoder::testReceivePackets()
+{
+    static constexpr char CHARS[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZ0123456789,.:";
+
+    for (const auto escaped : {false, true})
+    {
+        XBee::FrameDecoder decoder;
+        decoder.setEscaped(escaped);
+
+        // Frame type, 64-bit & 16-bit source addresses & receive options
+        QByteArray header(XBee::RECEIVE_PACKET_HEADER_SIZE, '\0');
+        header[0] = char(XBee::ReceivePacket);
+        qToBigEndian<quint64>(0x0013A2004183A626, header.data() + 1);
+        qToBigEndian<quint16>(0xFFFE, header.data() + 9);
+        header[11] = char(0x01);
+
+        QByteArray telemetry;
+        for (int size = 1; size <= 512; ++size)
+        {
+            telemetry.append(CHARS[size % (sizeof(CHARS) - 1)]);
+            decoder.append(apiFrame(header + telemetry, escaped));
+
+            QByteArrayView frame;
+            QVERIFY(decoder.next(frame));
+            QCOMPARE(static_cast<quint8>(frame.front()), quint8(XBee::ReceivePacket));
+            QCOMPARE(frame.sliced(XBee::RECEIVE_PACKET_HEADER_SIZE).toByteArray(),
+                     telemetry);
+        }
+
+        QCOMPARE(decoder.invalidFrames(), quint64(0));
+    }
+}
+
+/**
+ * Builds an API frame with the given frame @a data, escaping the bytes that follow
+ * the start delimiter if @a escaped is @c true
+ */
+QByteArray TestFrameDecoder::apiFrame(const QByteArray &data, const bool escaped)
+{
+    // Build frame
+    QByteArray frame;
+    frame.append(char(0x7E));
+    frame.append(char(data.size() >> 8));
+    frame.append(char(data.size() & 0xFF));
+    frame.append(data);
+
+    // Add checksum
+    quint8 sum = 0;
+    for (const auto byte : data)
+        sum += static_cast<quint8>(byte);
+
+    frame.append(char(0xFF - sum));
+
+    // Escape frame (except for the start delimiter)
+    if (!escaped)
+        return frame;
+
+    QByteArray result(1, frame.at(0));
+    for (qsizetype i = 1; i < frame.size(); ++i)
+    {
+        const auto byte = static_cast<quint8>(frame.at(i));
+        if (byte == 0x7E || byte == 0x7D || byte == 0x11 || byte == 0x13)
+        {
+            result.append(char(0x7D));
+            result.append(char(byte ^ 0x20));
+        }
+
+        else
+            result.append(char(byte));
+    }
+
+    return result;
+}
+
+QTEST_GUILESS_MAIN(TestFrameDecoder)
@@ -0,0 +1,57 @@
+/*
+ * Copyright (c) 2022 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#pragma once
+
+#include <QObject>
+#include <QByteArray>
+
+/**
+ * @brief Tests of the streaming XBee API frame decoder
+ *
+ * Frames are built by the test (with & without escaping) and fed to
+ * @c XBee::FrameDecoder in one piece, byte by byte & in large batches. Frames with
+ * invalid lengths or checksums must be rejected and counted without hiding the
+ * frames that follow them. Receive packets like the ones sent by the Serial Studio
+ * stub must give back their telemetry after the receive packet header.
+ */
+class TestFrameDecoder : public QObject
+{
+    // clang-format off
+    Q_OBJECT
+    // clang-format on
+
+private Q_SLOTS:
+    void testValidFrames();
+    void testFragmentation();
+    void testChecksum();
+    void testLength();
+    void testEscaping();
+    void testDelimiterInEscapedFrame();
+    void testResyncAfterBadDelimiter();
+    void testDiscardedBytes();
+    void testCompaction();
+    void testReceivePackets();
+
+private:
+    static QByteArray apiFrame(const QByteArray &data, const bool escaped = false);
+};
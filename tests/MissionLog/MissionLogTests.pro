@@ -0,0 +1,35 @@
+#-------------------------------------------------------------------------------
+# Make options
+#-------------------------------------------------------------------------------
+
+MOC_DIR = moc
+OBJECTS_DIR = obj
+
+CONFIG += c++17
+CONFIG += console testcase
+CONFIG -= app_bundle
+
+#-------------------------------------------------------------------------------
+# Qt configuration
+#-------------------------------------------------------------------------------
+
+TEMPLATE = app
+TARGET = MissionLogTests
+
+QT = core testlib
+
+#-------------------------------------------------------------------------------
+# Import source code
+#-------------------------------------------------------------------------------
+
+INCLUDEPATH += $$PWD/../../src
+
+HEADERS += \
+    testmissionlog.h \
+    ../../src/CanSat/MissionLog.h \
+    ../../src/Misc/LogWriter.h
+
+SOURCES += \
+    testmissionlog.cpp \
+    ../../src/CanSat/MissionLog.cpp \
+    ../../src/Misc/LogWriter.cpp
@@ -0,0 +1,346 @@
+/*
+ * Copyright (c) 2022 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "testmissionlog.h"
+
+#include <QFile>
+#include <QtTest>
+#include <QDateTime>
+
+/*
+ * Logged seconds (enough for several index blocks) & frames received per second
+ */
+static constexpr int SECONDS = 35;
+static constexpr int FRAMES_PER_SECOND = 5;
+
+/**
+ * Verifies that the temporary directory for the logs was created
+ */
+void TestMissionLog::initTestCase()
+{
+    QVERIFY(m_dir.isValid());
+}
+
+/**
+ * Reads back every frame of a closed log
+ */
+void TestMissionLog::testRoundTrip()
+{
+    const auto path = writeLog("RoundTrip.cclog");
+    QVERIFY(!path.isEmpty());
+
+    CanSat::MissionLogReader reader;
+    QVERIFY2(reader.open(path), qPrintable(reader.errorString()));
+
+    // Count the seconds that must be indexed
+    qsizetype seconds = 0;
+    for (qsizetype i = 0; i < m_frames.size(); ++i)
+    {
+        if (i == 0 || m_frames[i].timestamp / 1000 != m_frames[i - 1].timestamp / 1000)
+            ++seconds;
+    }
+
+    QCOMPARE(reader.indexedSeconds(), seconds);
+
+    // Compare frames
+    const auto frames = readAll(reader);
+    QCOMPARE(frames.size(), m_frames.size());
+    for (qsizetype i = 0; i < frames.size(); ++i)
+    {
+        QCOMPARE(frames[i].type, m_frames[i].type);
+        QCOMPARE(frames[i].timestamp, m_frames[i].timestamp);
+        QCOMPARE(frames[i].data, m_frames[i].data);
+    }
+
+    // Read again from the beginning
+    QVERIFY(reader.rewind());
+    QCOMPARE(readAll(reader).size(), m_frames.size());
+}
+
+/**
+ * Seeks to the seconds of several frames, before the first frame & after the last one
+ */
+void TestMissionLog::testSeek()
+{
+    const auto path = writeLog("Seek.cclog");
+    QVERIFY(!path.isEmpty());
+
+    CanSat::MissionLogReader reader;
+    QVERIFY(reader.open(path));
+
+    CanSat::MissionLogRecord record;
+    for (const auto second : { 0, 7, 10, 11, 23, SECONDS - 1 })
+    {
+        const auto timestamp = m_frames[second * FRAMES_PER_SECOND + 2].timestamp;
+        QVERIFY(reader.seek(timestamp));
+        QVERIFY(reader.readNext(record));
+        QCOMPARE(record.timestamp, firstTimestampFrom(timestamp));
+    }
+
+    QVERIFY(reader.seek(0));
+    QVERIFY(reader.readNext(record));
+    QCOMPARE(record.timestamp, m_frames.first().timestamp);
+
+    reader.seek(m_frames.last().timestamp + 1000);
+    QVERIFY(!reader.readNext(record));
+}
+
+/**
+ * Seeks to every second of the mission, relative to the creation time of the log
+ */
+void TestMissionLog::testSeekToMissionSecond()
+{
+    const auto path = writeLog("MissionSecond.cclog");
+    QVERIFY(!path.isEmpty());
+
+    CanSat::MissionLogReader reader;
+    QVERIFY(reader.open(path));
+    QVERIFY(reader.startTime() >= m_openTime);
+    QVERIFY(reader.startTime() <= m_frames.first().timestamp);
+
+    CanSat::MissionLogRecord record;
+    for (int second = 0; second <= SECONDS + 1; ++second)
+    {
+        const auto expected = firstTimestampFrom(reader.startTime() + second * 1000);
+        reader.seekToMissionSecond(second);
+        if (expected < 0)
+            QVERIFY(!reader.readNext(record));
+        else
+        {
+            QVERIFY(reader.readNext(record));
+            QCOMPARE(record.timestamp, expected);
+        }
+    }
+}
+
+/**
+ * Exports the payload & container frames to CSV files
+ */
+void TestMissionLog::testExportCsv()
+{
+    const auto path = writeLog("Export.cclog");
+    QVERIFY(!path.isEmpty());
+
+    CanSat::MissionLogReader reader;
+    QVERIFY(reader.open(path));
+
+    const auto types = { CanSat::MissionLogRecord::PayloadFrame,
+                         CanSat::MissionLogRecord::ContainerFrame };
+    for (const auto type : types)
+    {
+        QByteArray expected;
+        for (const auto &frame : qAsConst(m_frames))
+        {
+            if (frame.type == type)
+                expected.append(frame.data + '\n');
+        }
+
+        const auto csvPath = m_dir.filePath(QString("Export_%1.csv").arg(int(type)));
+        QVERIFY2(reader.exportCsv(csvPath, type), qPrintable(reader.errorString()));
+
+        QFile csv(csvPath);
+        QVERIFY(csv.open(QFile::ReadOnly));
+        QCOMPARE(csv.readAll(), expected);
+    }
+}
+
+/**
+ * Reads a log whose last index block is truncated (e.g. the application crashed while
+ * closing it), the index must be rebuilt from the records
+ */
+void TestMissionLog::testUnclosedLog()
+{
+    const auto path = writeLog("Unclosed.cclog");
+    QVERIFY(!path.isEmpty());
+
+    QFile file(path);
+    QVERIFY(file.resize(file.size() - 3));
+
+    CanSat::MissionLogReader reader;
+    QVERIFY(reader.open(path));
+    QCOMPARE(readAll(reader).size(), m_frames.size());
+
+    const auto timestamp = m_frames[17 * FRAMES_PER_SECOND + 3].timestamp;
+    CanSat::MissionLogRecord record;
+    QVERIFY(reader.seek(timestamp));
+    QVERIFY(reader.readNext(record));
+    QCOMPARE(record.timestamp, firstTimestampFrom(timestamp));
+}
+
+/**
+ * Writes a log whose timestamps jump back in time (e.g. the clock was set by NTP or
+ * GPS), the index must stay sorted so that seeking still finds the first record of
+ * each indexed second, with & without the index blocks written by the writer
+ */
+void TestMissionLog::testClockStepBack()
+{
+    static constexpr int FIRST_RUN = 15;
+    static constexpr int STEP_BACK = 10;
+    static constexpr int LAST_SECOND = 30;
+
+    // Two frames per second from 0 to 14 s, then from 5 to 29 s
+    const auto path = m_dir.filePath("ClockStepBack.cclog");
+    const auto base = QDateTime::currentMSecsSinceEpoch() / 1000 * 1000;
+    {
+        CanSat::MissionLogWriter writer;
+        QVERIFY(writer.open(path, Misc::LogWriter::Policy()));
+
+        int sequence = 0;
+        const auto write = [&](const int first, const int last) {
+            for (int second = first; second < last; ++second)
+            {
+                for (int i = 0; i < 2; ++i)
+                {
+                    writer.append(CanSat::MissionLogRecord::PayloadFrame,
+                                  base + second * 1000 + i * 500,
+                                  QByteArray::number(sequence++));
+                }
+            }
+        };
+
+        write(0, FIRST_RUN);
+        write(FIRST_RUN - STEP_BACK, LAST_SECOND);
+        writer.close();
+    }
+
+    // Read the closed log, then the log without its last index block
+    for (const auto truncate : { false, true })
+    {
+        if (truncate)
+        {
+            QFile file(path);
+            QVERIFY(file.resize(file.size() - 3));
+        }
+
+        CanSat::MissionLogReader reader;
+        QVERIFY(reader.open(path));
+        QCOMPARE(reader.indexedSeconds(), qsizetype(LAST_SECOND));
+
+        // Seconds before the step are found in the first run, the others after it
+        CanSat::MissionLogRecord record;
+        for (int second = 0; second < LAST_SECOND; ++second)
+        {
+            const auto sequence = second < FIRST_RUN ? second * 2
+                                                     : (second + STEP_BACK) * 2;
+
+            QVERIFY(reader.seek(base + second * 1000 + 250));
+            QVERIFY(reader.readNext(record));
+            QCOMPARE(record.timestamp, base + second * 1000);
+            QCOMPARE(record.data.toByteArray(), QByteArray::number(sequence));
+        }
+    }
+}
+
+/**
+ * Rejects files that are not mission logs
+ */
+void TestMissionLog::testInvalidFile()
+{
+    const auto path = m_dir.filePath("Invalid.cclog");
+    QFile file(path);
+    QVERIFY(file.open(QFile::WriteOnly));
+    file.write("6026,12:00:00.00,1,F\n");
+    file.close();
+
+    CanSat::MissionLogReader reader;
+    QVERIFY(!reader.open(path));
+    QVERIFY(!reader.errorString().isEmpty());
+    QVERIFY(!reader.open(m_dir.filePath("Missing.cclog")));
+}
+
+/**
+ * Writes a mission log with the given @a name & registers the frames written to it,
+ * returns the path of the log or an empty string if it cannot be created
+ */
+QString TestMissionLog::writeLog(const QString &name)
+{
+    const auto path = m_dir.filePath(name);
+    m_openTime = QDateTime::currentMSecsSinceEpoch();
+
+    CanSat::MissionLogWriter writer;
+    if (!writer.open(path, Misc::LogWriter::Policy()))
+        return QString();
+
+    // Container frame at the start of each second, payload frames & some garbage
+    m_frames.clear();
+    const auto base = QDateTime::currentMSecsSinceEpoch();
+    for (int second = 0; second < SECONDS; ++second)
+    {
+        for (int i = 0; i < FRAMES_PER_SECOND; ++i)
+        {
+            Frame frame;
+            const auto packet = QByteArray::number(second * FRAMES_PER_SECOND + i + 1);
+            frame.timestamp = base + second * 1000 + i * 150;
+            if (i == 0)
+            {
+                frame.type = CanSat::MissionLogRecord::ContainerFrame;
+                frame.data = "1099,12:00:00.00," + packet + ",F,DESCENT,500.0";
+            }
+            else if (packet.endsWith('7'))
+            {
+                frame.type = CanSat::MissionLogRecord::UnknownFrame;
+                frame.data = "garbage " + packet;
+            }
+            else
+            {
+                frame.type = CanSat::MissionLogRecord::PayloadFrame;
+                frame.data = "6026,12:00:00.00," + packet + ",T,350.0,22.4";
+            }
+
+            writer.append(frame.type, frame.timestamp, frame.data);
+            m_frames.append(frame);
+        }
+    }
+
+    writer.close();
+    return path;
+}
+
+/**
+ * Reads the remaining frames of the log
+ */
+QVector<TestMissionLog::Frame> TestMissionLog::readAll(CanSat::MissionLogReader &reader)
+{
+    QVector<Frame> frames;
+    CanSat::MissionLogRecord record;
+    while (reader.readNext(record))
+        frames.append({ record.type, record.timestamp, record.data.toByteArray() });
+
+    return frames;
+}
+
+/**
+ * Returns the timestamp of the first frame received during the second that contains
+ * the given @a timestamp or later, or -1 if there is no such frame
+ */
+qint64 TestMissionLog::firstTimestampFrom(const qint64 timestamp) const
+{
+    for (const auto &frame : m_frames)
+    {
+        if (frame.timestamp / 1000 >= timestamp / 1000)
+            return frame.timestamp;
+    }
+
+    return -1;
+}
+
+QTEST_GUILESS_MAIN(TestMissionLog)
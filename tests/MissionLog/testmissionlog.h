@@ -0,0 +1,71 @@
+/*
+ * Copyright (c) 2022 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#pragma once
+
+#include <QObject>
+#include <QVector>
+#include <QTemporaryDir>
+
+#include <CanSat/MissionLog.h>
+
+/**
+ * @brief Round-trip tests of the binary mission log
+ *
+ * Frames are written with @c CanSat::MissionLogWriter and read back with
+ * @c CanSat::MissionLogReader, which must return them unchanged, seek to any second
+ * of the mission, export them to CSV & recover logs that were not closed properly.
+ * Seeking must keep working when the clock is set back while the log is written.
+ */
+class TestMissionLog : public QObject
+{
+    // clang-format off
+    Q_OBJECT
+    // clang-format on
+
+private Q_SLOTS:
+    void initTestCase();
+    void testRoundTrip();
+    void testSeek();
+    void testSeekToMissionSecond();
+    void testExportCsv();
+    void testUnclosedLog();
+    void testClockStepBack();
+    void testInvalidFile();
+
+private:
+    struct Frame
+    {
+        CanSat::MissionLogRecord::Type type;
+        qint64 timestamp;
+        QByteArray data;
+    };
+
+    QString writeLog(const QString &name);
+    QVector<Frame> readAll(CanSat::MissionLogReader &reader);
+    qint64 firstTimestampFrom(const qint64 timestamp) const;
+
+private:
+    QTemporaryDir m_dir;
+    qint64 m_openTime;
+    QVector<Frame> m_frames;
+};
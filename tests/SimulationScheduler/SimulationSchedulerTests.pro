@@ -0,0 +1,36 @@
+#-------------------------------------------------------------------------------
+# Make options
+#-------------------------------------------------------------------------------
+
+MOC_DIR = moc
+OBJECTS_DIR = obj
+
+CONFIG += c++17
+CONFIG += console testcase
+CONFIG -= app_bundle
+
+#-------------------------------------------------------------------------------
+# Qt configuration
+#-------------------------------------------------------------------------------
+
+TEMPLATE = app
+TARGET = SimulationSchedulerTests
+
+QT = core testlib
+
+#-------------------------------------------------------------------------------
+# Import source code
+#-------------------------------------------------------------------------------
+
+INCLUDEPATH += $$PWD/../../src
+
+HEADERS += \
+    testsimulationscheduler.h \
+    ../../src/Misc/SteadyClock.h \
+    ../../src/Misc/LatencyHistogram.h \
+    ../../src/CanSat/SimulationScheduler.h
+
+SOURCES += \
+    testsimulationscheduler.cpp \
+    ../../src/Misc/LatencyHistogram.cpp \
+    ../../src/CanSat/SimulationScheduler.cpp
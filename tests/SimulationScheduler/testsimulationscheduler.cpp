@@ -0,0 +1,132 @@
+/*
+ * Copyright (c) 2022 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "testsimulationscheduler.h"
+
+#include <QtTest>
+#include <QThread>
+#include <QSettings>
+
+#include <CanSat/SimulationScheduler.h>
+
+/*
+ * Tick rate (in Hz), duration of the stall (in milliseconds) & deadlines that elapse
+ * during the stall
+ */
+static constexpr int RATE = 100;
+static constexpr int STALL_MS = 300;
+static constexpr quint64 STALL_TICKS = STALL_MS * RATE / 1000;
+
+/*
+ * Tick after which the event loop is blocked & number of ticks received per test
+ */
+static constexpr int STALL_AFTER = 3;
+static constexpr int TICKS = 12;
+
+/*
+ * Maximum number of missed ticks that are emitted at once with the catch-up policy
+ */
+static constexpr int MAX_CATCH_UP_TICKS = 5;
+
+/**
+ * Stores the scheduler settings in a temporary directory
+ */
+void TestSimulationScheduler::initTestCase()
+{
+    QVERIFY(m_dir.isValid());
+    QSettings::setDefaultFormat(QSettings::IniFormat);
+    QSettings::setPath(QSettings::IniFormat, QSettings::UserScope, m_dir.path());
+    QSettings().setValue("Simulation/RateHz", RATE);
+}
+
+/**
+ * With the skip policy, the first tick after the stall must jump over the missed
+ * deadlines instead of continuing from the row where the stall started
+ */
+void TestSimulationScheduler::testSkipAfterStall()
+{
+    run("Skip");
+    if (QTest::currentTestFailed())
+        return;
+
+    for (int i = 1; i < STALL_AFTER; ++i)
+        QVERIFY(m_indices[i] > m_indices[i - 1]);
+
+    QVERIFY(m_indices[STALL_AFTER] >= m_indices[STALL_AFTER - 1] + STALL_TICKS);
+    for (int i = STALL_AFTER + 1; i < TICKS; ++i)
+        QVERIFY(m_indices[i] > m_indices[i - 1]);
+
+    // Every index that was not emitted was counted as skipped
+    QCOMPARE(m_skipped, m_indices.last() + 1 - TICKS);
+}
+
+/**
+ * With the catch-up policy, a burst of consecutive rows must be emitted after the
+ * stall, ending at the last deadline that elapsed during the stall
+ */
+void TestSimulationScheduler::testCatchUpAfterStall()
+{
+    run("CatchUp");
+    if (QTest::currentTestFailed())
+        return;
+
+    const auto burstEnd = STALL_AFTER + MAX_CATCH_UP_TICKS - 1;
+    for (int i = STALL_AFTER + 1; i <= burstEnd; ++i)
+        QCOMPARE(m_indices[i], m_indices[i - 1] + 1);
+
+    QVERIFY(m_indices[burstEnd] >= m_indices[STALL_AFTER - 1] + STALL_TICKS);
+    for (int i = burstEnd + 1; i < TICKS; ++i)
+        QVERIFY(m_indices[i] > m_indices[i - 1]);
+
+    QVERIFY(m_skipped >= STALL_TICKS - MAX_CATCH_UP_TICKS);
+    QCOMPARE(m_skipped, m_indices.last() + 1 - TICKS);
+}
+
+/**
+ * Runs the scheduler with the given catch-up @a policy, blocks the event loop from
+ * a tick handler & records the indices of the received ticks
+ */
+void TestSimulationScheduler::run(const QString &policy)
+{
+    QSettings().setValue("Simulation/CatchUpPolicy", policy);
+
+    m_skipped = 0;
+    m_indices.clear();
+
+    CanSat::SimulationScheduler scheduler;
+    connect(&scheduler, &CanSat::SimulationScheduler::tick, this,
+            [&](const quint64 index) {
+                m_indices.append(index);
+                if (m_indices.size() == STALL_AFTER)
+                    QThread::msleep(STALL_MS);
+                if (m_indices.size() == TICKS)
+                    scheduler.stop();
+            });
+
+    scheduler.start(0);
+    QTRY_VERIFY_WITH_TIMEOUT(!scheduler.isRunning(), 5000);
+    QCOMPARE(scheduler.ticks(), quint64(TICKS));
+
+    m_skipped = scheduler.skippedTicks();
+}
+
+QTEST_GUILESS_MAIN(TestSimulationScheduler)
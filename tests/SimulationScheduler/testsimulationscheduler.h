@@ -0,0 +1,54 @@
+/*
+ * Copyright (c) 2022 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#pragma once
+
+#include <QObject>
+#include <QVector>
+#include <QTemporaryDir>
+
+/**
+ * @brief Pacing tests of the simulation scheduler
+ *
+ * The event loop is blocked for several periods from a tick handler, after which the
+ * index carried by the ticks (used as the row of the pressure profile) must match the
+ * deadlines that elapsed during the stall with both catch-up policies.
+ */
+class TestSimulationScheduler : public QObject
+{
+    // clang-format off
+    Q_OBJECT
+    // clang-format on
+
+private Q_SLOTS:
+    void initTestCase();
+    void testSkipAfterStall();
+    void testCatchUpAfterStall();
+
+private:
+    void run(const QString &policy);
+
+private:
+    QTemporaryDir m_dir;
+    quint64 m_skipped;
+    QVector<quint64> m_indices;
+};
@@ -0,0 +1,35 @@
+#-------------------------------------------------------------------------------
+# Make options
+#-------------------------------------------------------------------------------
+
+MOC_DIR = moc
+OBJECTS_DIR = obj
+
+CONFIG += c++17
+CONFIG += console testcase
+CONFIG -= app_bundle
+
+#-------------------------------------------------------------------------------
+# Qt configuration
+#-------------------------------------------------------------------------------
+
+TEMPLATE = app
+TARGET = TelemetryDecoderTests
+
+QT = core testlib
+
+#-------------------------------------------------------------------------------
+# Import source code
+#-------------------------------------------------------------------------------
+
+INCLUDEPATH += $$PWD/../../src
+
+HEADERS += \
+    testtelemetrydecoder.h \
+    ../../src/Misc/NumberParser.h \
+    ../../src/CanSat/Telemetry.h \
+    ../../src/CanSat/TelemetryDecoder.h
+
+SOURCES += \
+    testtelemetrydecoder.cpp \
+    ../../src/CanSat/TelemetryDecoder.cpp
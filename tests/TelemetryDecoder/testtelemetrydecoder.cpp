@@ -0,0 +1,238 @@
+/*
+ * Copyright (c) 2022 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "testtelemetrydecoder.h"
+
+#include <cmath>
+#include <cstring>
+#include <type_traits>
+
+#include <QtTest>
+
+#include <Misc/NumberParser.h>
+#include <CanSat/TelemetryDecoder.h>
+
+/*
+ * Valid container & payload frames
+ */
+static constexpr char CONTAINER_FRAME[]
+    = "1099,12:34:56.78,42,F,ASCENT,123.4,N,P,M,25.3,101.3,5.02,12:34:56,130.2,"
+      "37.1234567,-80.1234567,7,1.5,-2.5,CXON";
+static constexpr char PAYLOAD_FRAME[]
+    = "6026,12:34:56.78,10,P,500.5,22.1,4.9,1,2,3,-4,5,6,7,8,9,10.5,RELEASED";
+
+/*
+ * Parses the whole @a text with the number parser that matches the value type,
+ * returns @c false if the text was not fully consumed
+ */
+template<typename T>
+static bool parseAll(const char *text, T &value)
+{
+    const auto last = text + std::strlen(text);
+    if constexpr (std::is_floating_point_v<T>)
+        return Misc::NumberParser::parseDecimal(text, last, value) == last;
+    else
+        return Misc::NumberParser::parseInteger(text, last, value) == last;
+}
+
+/**
+ * Parses integers with optional signs & rejects repeated signs
+ */
+void TestTelemetryDecoder::testParseInteger()
+{
+    int value = 0;
+    QVERIFY(parseAll("42", value));
+    QCOMPARE(value, 42);
+    QVERIFY(parseAll("+7", value));
+    QCOMPARE(value, 7);
+    QVERIFY(parseAll("-5", value));
+    QCOMPARE(value, -5);
+
+    // A sign after the plus sign is not part of the number
+    value = 0;
+    const char text[] = "+-5";
+    QVERIFY(Misc::NumberParser::parseInteger(text, text + 3, value) == text);
+    QCOMPARE(value, 0);
+    QVERIFY(!parseAll("++5", value));
+    QVERIFY(!parseAll("", value));
+
+    quint16 unsignedValue = 0;
+    QVERIFY(!parseAll("-1", unsignedValue));
+    QVERIFY(!parseAll("70000", unsignedValue));
+}
+
+/**
+ * Parses decimals with fractional parts & exponents
+ */
+void TestTelemetryDecoder::testParseDecimal()
+{
+    double value = 0;
+    QVERIFY(parseAll("3.25", value));
+    QCOMPARE(value, 3.25);
+    QVERIFY(parseAll("-0.5", value));
+    QCOMPARE(value, -0.5);
+    QVERIFY(parseAll(".5", value));
+    QCOMPARE(value, 0.5);
+    QVERIFY(parseAll("1e3", value));
+    QCOMPARE(value, 1000.0);
+    QVERIFY(parseAll("1.5E-2", value));
+    QCOMPARE(value, 0.015);
+    QVERIFY(parseAll("-80.1234567", value));
+    QCOMPARE(value, -80.1234567);
+
+    // Exponents without digits are not consumed
+    const char text[] = "2e+";
+    QVERIFY(Misc::NumberParser::parseDecimal(text, text + 3, value) == text + 1);
+    QCOMPARE(value, 2.0);
+    QVERIFY(!parseAll("1e+-5", value));
+    QVERIFY(!parseAll("+-5", value));
+    QVERIFY(!parseAll("-", value));
+}
+
+/**
+ * Corrupted exponents are clamped & turn the number into infinity or zero
+ */
+void TestTelemetryDecoder::testOverlongExponent()
+{
+    double value = 0;
+    QVERIFY(parseAll("1e2000000000", value));
+    QVERIFY(std::isinf(value) && value > 0);
+    QVERIFY(parseAll("-1e2000000000", value));
+    QVERIFY(std::isinf(value) && value < 0);
+    QVERIFY(parseAll("1e-2000000000", value));
+    QCOMPARE(value, 0.0);
+    QVERIFY(parseAll("1e99999999999999999999", value));
+    QVERIFY(std::isinf(value));
+    QVERIFY(parseAll("0e99999", value));
+    QCOMPARE(value, 0.0);
+
+    // More than 19 integer digits with a large exponent
+    QVERIFY(parseAll("12345678901234567890123456789e2147483000", value));
+    QVERIFY(std::isinf(value));
+
+    float single = 0;
+    QVERIFY(parseAll("3e400", single));
+    QVERIFY(std::isinf(single));
+}
+
+/**
+ * Decodes every field of a container frame
+ */
+void TestTelemetryDecoder::testContainerFrame()
+{
+    CanSat::ContainerTelemetry telemetry;
+    QVERIFY(CanSat::TelemetryDecoder::decode(QByteArrayView(CONTAINER_FRAME), telemetry));
+
+    QCOMPARE(telemetry.teamId, quint16(1099));
+    QCOMPARE(telemetry.missionTime.msecs, (12 * 3600 + 34 * 60) * 1000 + 56780);
+    QCOMPARE(telemetry.packetCount, quint32(42));
+    QCOMPARE(telemetry.mode, 'F');
+    QCOMPARE(telemetry.state.view().toByteArray(), QByteArray("ASCENT"));
+    QCOMPARE(telemetry.altitude, 123.4f);
+    QCOMPARE(telemetry.hsDeployed, 'N');
+    QCOMPARE(telemetry.pcDeployed, 'P');
+    QCOMPARE(telemetry.mastRaised, 'M');
+    QCOMPARE(telemetry.temperature, 25.3f);
+    QCOMPARE(telemetry.pressure, 101.3f);
+    QCOMPARE(telemetry.voltage, 5.02f);
+    QCOMPARE(telemetry.gpsTime.msecs, (12 * 3600 + 34 * 60 + 56) * 1000);
+    QCOMPARE(telemetry.gpsAltitude, 130.2f);
+    QCOMPARE(telemetry.gpsLatitude, 37.1234567);
+    QCOMPARE(telemetry.gpsLongitude, -80.1234567);
+    QCOMPARE(telemetry.gpsSats, quint8(7));
+    QCOMPARE(telemetry.tiltX, 1.5f);
+    QCOMPARE(telemetry.tiltY, -2.5f);
+    QCOMPARE(telemetry.cmdEcho.view().toByteArray(), QByteArray("CXON"));
+}
+
+/**
+ * Decodes every field of a payload frame, including the trailing line break
+ */
+void TestTelemetryDecoder::testPayloadFrame()
+{
+    const QByteArray frame = QByteArray(PAYLOAD_FRAME) + "\r\n";
+
+    CanSat::PayloadTelemetry telemetry;
+    QVERIFY(CanSat::TelemetryDecoder::decode(frame, telemetry));
+
+    QCOMPARE(telemetry.teamId, quint16(6026));
+    QCOMPARE(telemetry.packetCount, quint32(10));
+    QCOMPARE(telemetry.packetType, 'P');
+    QCOMPARE(telemetry.altitude, 500.5f);
+    QCOMPARE(telemetry.temperature, 22.1f);
+    QCOMPARE(telemetry.voltage, 4.9f);
+    QCOMPARE(telemetry.gyroR, 1.0f);
+    QCOMPARE(telemetry.accelR, -4.0f);
+    QCOMPARE(telemetry.magY, 9.0f);
+    QCOMPARE(telemetry.pointingError, 10.5f);
+    QCOMPARE(telemetry.state.view().toByteArray(), QByteArray("RELEASED"));
+}
+
+/**
+ * Frames with an extra (empty) field or a missing field are rejected
+ */
+void TestTelemetryDecoder::testTrailingComma()
+{
+    CanSat::ContainerTelemetry container;
+    QVERIFY(!CanSat::TelemetryDecoder::decode(QByteArray(CONTAINER_FRAME) + ",",
+                                              container));
+
+    CanSat::PayloadTelemetry payload;
+    QVERIFY(!CanSat::TelemetryDecoder::decode(QByteArray(PAYLOAD_FRAME) + ",", payload));
+    QVERIFY(!CanSat::TelemetryDecoder::decode(QByteArray(PAYLOAD_FRAME) + ",\r\n",
+                                              payload));
+
+    // Missing last field
+    auto frame = QByteArray(PAYLOAD_FRAME);
+    frame.truncate(frame.lastIndexOf(','));
+    QVERIFY(!CanSat::TelemetryDecoder::decode(frame, payload));
+    QVERIFY(!CanSat::TelemetryDecoder::decode(QByteArrayView(), payload));
+}
+
+/**
+ * Frames with malformed fields are rejected
+ */
+void TestTelemetryDecoder::testInvalidFields()
+{
+    CanSat::PayloadTelemetry telemetry;
+
+    // Packet count with two signs
+    auto frame = QByteArray(PAYLOAD_FRAME);
+    frame.replace(",10,", ",+-10,");
+    QVERIFY(!CanSat::TelemetryDecoder::decode(frame, telemetry));
+
+    // Corrupted altitude exponent (decoded, but clamped to infinity)
+    frame = QByteArray(PAYLOAD_FRAME);
+    frame.replace(",500.5,", ",1e2000000000,");
+    QVERIFY(CanSat::TelemetryDecoder::decode(frame, telemetry));
+    QVERIFY(std::isinf(telemetry.altitude));
+
+    // Invalid mission time & oversized state
+    frame = QByteArray(PAYLOAD_FRAME);
+    frame.replace("12:34:56.78", "12:60:00");
+    QVERIFY(!CanSat::TelemetryDecoder::decode(frame, telemetry));
+    frame = QByteArray(PAYLOAD_FRAME);
+    frame.replace("RELEASED", "RELEASED_AFTER_A_LONG_DESCENT");
+    QVERIFY(!CanSat::TelemetryDecoder::decode(frame, telemetry));
+}
+
+QTEST_GUILESS_MAIN(TestTelemetryDecoder)
@@ -0,0 +1,48 @@
+/*
+ * Copyright (c) 2022 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#pragma once
+
+#include <QObject>
+
+/**
+ * @brief Tests of the telemetry frame decoder & the number parsing functions
+ *
+ * Valid container & payload frames must be decoded field by field, while frames with
+ * missing or extra fields (e.g. a trailing comma) and malformed numbers must be
+ * rejected. Corrupted exponents must be clamped instead of being evaluated.
+ */
+class TestTelemetryDecoder : public QObject
+{
+    // clang-format off
+    Q_OBJECT
+    // clang-format on
+
+private Q_SLOTS:
+    void testParseInteger();
+    void testParseDecimal();
+    void testOverlongExponent();
+    void testContainerFrame();
+    void testPayloadFrame();
+    void testTrailingComma();
+    void testInvalidFields();
+};
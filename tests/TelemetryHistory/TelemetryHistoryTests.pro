@@ -0,0 +1,33 @@
+#-------------------------------------------------------------------------------
+# Make options
+#-------------------------------------------------------------------------------
+
+MOC_DIR = moc
+OBJECTS_DIR = obj
+
+CONFIG += c++17
+CONFIG += console testcase
+CONFIG -= app_bundle
+
+#-------------------------------------------------------------------------------
+# Qt configuration
+#-------------------------------------------------------------------------------
+
+TEMPLATE = app
+TARGET = TelemetryHistoryTests
+
+QT = core testlib
+
+#-------------------------------------------------------------------------------
+# Import source code
+#-------------------------------------------------------------------------------
+
+INCLUDEPATH += $$PWD/../../src
+
+HEADERS += \
+    testtelemetryhistory.h \
+    ../../src/CanSat/Telemetry.h \
+    ../../src/CanSat/TelemetryHistory.h
+
+SOURCES += \
+    testtelemetryhistory.cpp
@@ -0,0 +1,191 @@
+/*
+ * Copyright (c) 2022 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "testtelemetryhistory.h"
+
+#include <QtTest>
+
+#include <CanSat/TelemetryHistory.h>
+
+using Payload = CanSat::PayloadTelemetry;
+using History = CanSat::TelemetryHistory<Payload>;
+
+/*
+ * Positions of the fields that are checked in the payload frame schema
+ */
+static constexpr auto PACKET_COUNT = CanSat::fieldIndex<Payload>("PACKET_COUNT");
+static constexpr auto ALTITUDE = CanSat::fieldIndex<Payload>("ALTITUDE");
+static constexpr auto STATE = CanSat::fieldIndex<Payload>("STATE");
+
+/*
+ * Number of frames that fit in the history used by most tests
+ */
+static constexpr std::size_t CAPACITY = 10;
+
+/*
+ * Builds a payload frame whose fields are derived from the given frame @a number
+ */
+static Payload payloadFrame(const int number)
+{
+    Payload frame;
+    frame.packetCount = static_cast<quint32>(number);
+    frame.altitude = number * 1.5f;
+    frame.state.assign(QByteArray::number(number));
+    return frame;
+}
+
+/*
+ * Appends the frames with numbers in the [@a first, @a last) range to the @a history,
+ * the timestamp of each frame is 1000 + its number
+ */
+static void appendFrames(History &history, const int first, const int last)
+{
+    for (int i = first; i < last; ++i)
+        history.append(1000 + i, payloadFrame(i));
+}
+
+/*
+ * Verifies that the history contains the frames with numbers in the
+ * [@a first, @a last) range, from oldest to newest
+ */
+static void verifyFrames(const History &history, const int first, const int last)
+{
+    const auto count = static_cast<std::size_t>(last - first);
+    const auto timestamps = history.timestamps();
+    const auto packets = history.column<PACKET_COUNT>();
+    const auto altitudes = history.column<ALTITUDE>();
+    const auto states = history.column<STATE>();
+
+    QCOMPARE(history.size(), count);
+    QCOMPARE(timestamps.size(), count);
+    QCOMPARE(packets.size(), count);
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        const auto number = first + static_cast<int>(i);
+        QCOMPARE(timestamps[i], qint64(1000 + number));
+        QCOMPARE(packets[i], quint32(number));
+        QCOMPARE(altitudes[i], number * 1.5f);
+        QCOMPARE(states[i].view().toByteArray(), QByteArray::number(number));
+    }
+}
+
+/**
+ * The capacity is the number of rows (fields & timestamp) that fit in the budget
+ */
+void TestTelemetryHistory::testBudget()
+{
+    // Sum of the field sizes of a payload frame, plus the timestamp
+    const auto rowSize = sizeof(quint16) + sizeof(CanSat::MissionClock) + sizeof(quint32)
+                       + sizeof(char) + 13 * sizeof(float)
+                       + sizeof(CanSat::FixedString<16>) + sizeof(qint64);
+    QCOMPARE(History::ROW_SIZE, rowSize);
+
+    History exact(CAPACITY * History::ROW_SIZE);
+    QCOMPARE(exact.capacity(), CAPACITY);
+
+    History rounded(CAPACITY * History::ROW_SIZE + History::ROW_SIZE - 1);
+    QCOMPARE(rounded.capacity(), CAPACITY);
+
+    History large(8 * 1024 * 1024);
+    QCOMPARE(large.capacity(), std::size_t(8 * 1024 * 1024) / History::ROW_SIZE);
+
+    // At least one frame is always kept
+    History empty(0);
+    QCOMPARE(empty.capacity(), std::size_t(1));
+    QVERIFY(empty.isEmpty());
+}
+
+/**
+ * Frames are stored in a single segment until the history is full
+ */
+void TestTelemetryHistory::testAppend()
+{
+    History history(CAPACITY * History::ROW_SIZE);
+    appendFrames(history, 0, 4);
+    verifyFrames(history, 0, 4);
+
+    const auto packets = history.column<PACKET_COUNT>();
+    QCOMPARE(packets.firstSize, std::size_t(4));
+    QCOMPARE(packets.secondSize, std::size_t(0));
+
+    appendFrames(history, 4, CAPACITY);
+    verifyFrames(history, 0, CAPACITY);
+    QCOMPARE(history.column<PACKET_COUNT>().secondSize, std::size_t(0));
+}
+
+/**
+ * Appending more frames than the capacity keeps the newest ones & the same capacity
+ */
+void TestTelemetryHistory::testAppendPastCapacity()
+{
+    History history(CAPACITY * History::ROW_SIZE);
+    appendFrames(history, 0, 1000);
+
+    QCOMPARE(history.capacity(), CAPACITY);
+    verifyFrames(history, 1000 - CAPACITY, 1000);
+}
+
+/**
+ * After the ring buffer wraps around, the columns are split in two segments that
+ * continue each other, from oldest to newest value
+ */
+void TestTelemetryHistory::testWrapAround()
+{
+    History history(CAPACITY * History::ROW_SIZE);
+    appendFrames(history, 0, 25);
+    verifyFrames(history, 15, 25);
+
+    // Oldest values are at the end of the storage, newest ones at the beginning
+    const auto packets = history.column<PACKET_COUNT>();
+    QCOMPARE(packets.firstSize, std::size_t(5));
+    QCOMPARE(packets.secondSize, std::size_t(5));
+    for (std::size_t i = 0; i < packets.firstSize; ++i)
+        QCOMPARE(packets.first[i], quint32(15 + i));
+    for (std::size_t i = 0; i < packets.secondSize; ++i)
+        QCOMPARE(packets.second[i], quint32(20 + i));
+
+    // The timestamps column is split at the same position
+    const auto timestamps = history.timestamps();
+    QCOMPARE(timestamps.firstSize, packets.firstSize);
+    QCOMPARE(timestamps.first[0], qint64(1015));
+    QCOMPARE(timestamps.second[0], qint64(1020));
+}
+
+/**
+ * Clearing the history keeps its capacity & starts again from the first row
+ */
+void TestTelemetryHistory::testClear()
+{
+    History history(CAPACITY * History::ROW_SIZE);
+    appendFrames(history, 0, 15);
+    history.clear();
+
+    QVERIFY(history.isEmpty());
+    QCOMPARE(history.capacity(), CAPACITY);
+    QCOMPARE(history.timestamps().size(), std::size_t(0));
+
+    appendFrames(history, 100, 103);
+    verifyFrames(history, 100, 103);
+    QCOMPARE(history.column<PACKET_COUNT>().secondSize, std::size_t(0));
+}
+
+QTEST_GUILESS_MAIN(TestTelemetryHistory)
@@ -0,0 +1,75 @@
+#-------------------------------------------------------------------------------
+# Make options
+#-------------------------------------------------------------------------------
+
+MOC_DIR = moc
+OBJECTS_DIR = obj
+
+CONFIG += c++17
+CONFIG += console
+CONFIG -= app_bundle
+
+#-------------------------------------------------------------------------------
+# Qt configuration
+#-------------------------------------------------------------------------------
+
+TEMPLATE = app
+TARGET = Benchmark
+
+QT = core network
+
+win32: LIBS += -lpsapi
+
+#-------------------------------------------------------------------------------
+# Compiler options
+#-------------------------------------------------------------------------------
+
+*g++*: {
+    QMAKE_CXXFLAGS_RELEASE -= -O
+    QMAKE_CXXFLAGS_RELEASE *= -O3
+}
+
+*msvc*: {
+    QMAKE_CXXFLAGS_RELEASE -= /O
+    QMAKE_CXXFLAGS_RELEASE *= /O2
+}
+
+#-------------------------------------------------------------------------------
+# Import source code
+#-------------------------------------------------------------------------------
+
+INCLUDEPATH += $$PWD/src
+INCLUDEPATH += $$PWD/../../src
+
+HEADERS += \
+    src/Benchmark.h \
+    src/Feeder.h \
+    src/ProcessStats.h \
+    ../../src/Misc/LatencyHistogram.h \
+    ../../src/Misc/LogWriter.h \
+    ../../src/Misc/Notifications.h \
+    ../../src/Misc/TimerEvents.h \
+    ../../src/CanSat/FrameScanner.h \
+    ../../src/CanSat/IngestionWorker.h \
+    ../../src/CanSat/MissionLog.h \
+    ../../src/CanSat/TelemetryDecoder.h \
+    ../../src/SerialStudio/JsonFramer.h \
+    ../../src/SerialStudio/Plugin.h \
+    ../../src/XBee/FrameDecoder.h
+
+SOURCES += \
+    src/main.cpp \
+    src/Benchmark.cpp \
+    src/Feeder.cpp \
+    src/ProcessStats.cpp \
+    ../../src/Misc/LatencyHistogram.cpp \
+    ../../src/Misc/LogWriter.cpp \
+    ../../src/Misc/Notifications.cpp \
+    ../../src/Misc/TimerEvents.cpp \
+    ../../src/CanSat/FrameScanner.cpp \
+    ../../src/CanSat/IngestionWorker.cpp \
+    ../../src/CanSat/MissionLog.cpp \
+    ../../src/CanSat/TelemetryDecoder.cpp \
+    ../../src/SerialStudio/JsonFramer.cpp \
+    ../../src/SerialStudio/Plugin.cpp \
+    ../../src/XBee/FrameDecoder.cpp
@@ -0,0 +1,318 @@
+/*
+ * Copyright (c) 2022 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "Benchmark.h"
+
+#include <QDebug>
+#include <QDirIterator>
+#include <QElapsedTimer>
+#include <QCoreApplication>
+
+#include <ProcessStats.h>
+#include <Misc/SteadyClock.h>
+#include <SerialStudio/Plugin.h>
+#include <CanSat/IngestionWorker.h>
+
+/*
+ * Time to wait for the last frames after the feeder finished, in milliseconds
+ */
+static constexpr int DRAIN_TIMEOUT = 10000;
+
+/**
+ * Constructor function, log files are written to the given @a logPath
+ */
+Benchmark::Benchmark(const QString &logPath)
+    : m_logPath(logPath)
+    , m_feeder(new Feeder)
+    , m_feederDone(false)
+    , m_tableSize(0)
+    , m_framesTaken(0)
+    , m_invalidFrames(0)
+    , m_lastTakeTime(0)
+{
+    // Run the feeder in its own thread
+    m_feeder->moveToThread(&m_feederThread);
+    connect(&m_feederThread, &QThread::finished, m_feeder, &QObject::deleteLater);
+    connect(
+        m_feeder, &Feeder::finished, m_feeder,
+        [=] { m_feederDone.store(true, std::memory_order_release); },
+        Qt::DirectConnection);
+
+    m_feederThread.setObjectName("Feeder");
+    m_feederThread.start();
+}
+
+/**
+ * Stops the ingestion & feeder threads
+ */
+Benchmark::~Benchmark()
+{
+    CanSat::IngestionWorker::instance().stop();
+    m_feederThread.quit();
+    m_feederThread.wait();
+}
+
+/**
+ * Returns the benchmark scenarios, paced scenarios last @a duration seconds
+ */
+QVector<Scenario> Benchmark::scenarios(const int duration)
+{
+    // clang-format off
+    return {
+        // name               frames             burst  interval  fragment  noise
+        { "steady-1hz",       duration,          1,     1000,     0,        0  },
+        { "burst-10hz",       duration * 10,     10,    1000,     0,        0  },
+        { "sustained-5khz",   duration * 5000,   5,     1,        0,        0  },
+        { "backlog-flush",    50000,             0,     0,        0,        0  },
+        { "fragmented-1khz",  duration * 1000,   1,     1,        16,       0  },
+        { "noisy-1khz",       duration * 1000,   1,     1,        0,        64 },
+    };
+    // clang-format on
+}
+
+/**
+ * Starts the feeder on the given TCP @a port & the ingestion thread, then waits until
+ * the Serial Studio plugin is connected to the feeder
+ */
+bool Benchmark::start(const quint16 port)
+{
+    // Start feeder
+    bool listening = false;
+    QMetaObject::invokeMethod(
+        m_feeder, [&] { listening = m_feeder->listen(port); },
+        Qt::BlockingQueuedConnection);
+
+    if (!listening)
+    {
+        qCritical().noquote() << "[Benchmark] Cannot listen on port" << port;
+        return false;
+    }
+
+    // Start ingestion thread & connect to the feeder
+    auto &plugin = SerialStudio::Plugin::instance();
+    plugin.setPort(port);
+    CanSat::IngestionWorker::instance().start();
+    QMetaObject::invokeMethod(&plugin, &SerialStudio::Plugin::tryConnection);
+    if (!waitFor([&] { return plugin.isConnected() && m_feeder->isConnected(); }, 5000))
+    {
+        qCritical().noquote() << "[Benchmark] Plugin did not connect to the feeder";
+        return false;
+    }
+
+    return true;
+}
+
+/**
+ * Runs the given @a scenario & returns its results
+ */
+QJsonObject Benchmark::run(const Scenario &scenario)
+{
+    // Allocate send time table (indexed by packet count, which starts at 1)
+    m_tableSize = scenario.frames + 1;
+    m_sendTimes.reset(new std::atomic<qint64>[m_tableSize]);
+    for (qint64 i = 0; i < m_tableSize; ++i)
+        m_sendTimes[i].store(0, std::memory_order_relaxed);
+
+    // Reset counters
+    m_framesTaken = 0;
+    m_invalidFrames = 0;
+    m_lastTakeTime = 0;
+    m_transport.clear();
+    m_delivery.clear();
+    m_endToEnd.clear();
+    m_feederDone.store(false, std::memory_order_release);
+
+    // Get initial state
+    auto &worker = CanSat::IngestionWorker::instance();
+    const auto droppedBefore = worker.droppedFrames();
+    const auto logBytesBefore = directorySize(m_logPath);
+    const auto cpuBefore = ProcessStats::cpuTime();
+    worker.start();
+
+    // Start feeder
+    QElapsedTimer wallClock;
+    wallClock.start();
+    QMetaObject::invokeMethod(m_feeder, [=] { m_feeder->run(scenario, m_sendTimes.get()); });
+
+    // Take frames until all of them have been received (or the drain timeout expires)
+    QElapsedTimer drainClock;
+    while (true)
+    {
+        consumeFrames();
+
+        const auto dropped = static_cast<qint64>(worker.droppedFrames() - droppedBefore);
+        if (m_framesTaken + dropped >= scenario.frames)
+            break;
+
+        if (m_feederDone.load(std::memory_order_acquire))
+        {
+            if (!drainClock.isValid())
+                drainClock.start();
+            else if (drainClock.elapsed() > DRAIN_TIMEOUT)
+                break;
+        }
+
+        QThread::usleep(1000);
+    }
+
+    // Stop ingestion thread, which flushes & closes the log files
+    QElapsedTimer flushClock;
+    flushClock.start();
+    worker.stop();
+    const auto flushTime = flushClock.elapsed();
+    const auto wallTime = wallClock.elapsed();
+
+    // Get resource usage
+    const auto cpuTime = ProcessStats::cpuTime() - cpuBefore;
+    const auto dropped = static_cast<qint64>(worker.droppedFrames() - droppedBefore);
+    const auto logBytes = directorySize(m_logPath) - logBytesBefore;
+
+    // Get sustained throughput
+    const auto firstSend = m_sendTimes[1].load(std::memory_order_relaxed);
+    const auto activeTime = qMax<qint64>(1, m_lastTakeTime - firstSend);
+    const auto framesPerSecond = m_framesTaken * 1e6 / activeTime;
+
+    // Build results
+    QJsonObject latency;
+    latency.insert("transport", histogramJson(m_transport));
+    latency.insert("delivery", histogramJson(m_delivery));
+    latency.insert("end_to_end", histogramJson(m_endToEnd));
+
+    QJsonObject results;
+    results.insert("name", scenario.name);
+    results.insert("frames_sent", scenario.frames);
+    results.insert("frames_received", m_framesTaken);
+    results.insert("frames_invalid", m_invalidFrames);
+    results.insert("frames_dropped", dropped);
+    results.insert("frames_missing", scenario.frames - m_framesTaken - dropped);
+    results.insert("frames_per_second", qRound64(framesPerSecond * 10) / 10.0);
+    results.insert("wall_time_ms", wallTime);
+    results.insert("cpu_time_ms", cpuTime / 1000);
+    results.insert("cpu_usage_percent", qRound64(cpuTime * 1000.0 / wallTime) / 10.0);
+    results.insert("peak_rss_kib", ProcessStats::peakMemory());
+    results.insert("log_bytes", logBytes);
+    results.insert("log_flush_ms", flushTime);
+    results.insert("latency_us", latency);
+
+    qInfo().noquote() << QString("[Benchmark] %1: %2/%3 frames, %4 frames/s, "
+                                 "p99 end-to-end %5 us, CPU %6 ms")
+                             .arg(scenario.name)
+                             .arg(m_framesTaken)
+                             .arg(scenario.frames)
+                             .arg(framesPerSecond, 0, 'f', 1)
+                             .arg(m_endToEnd.percentile(99))
+                             .arg(cpuTime / 1000);
+
+    return results;
+}
+
+/**
+ * Takes all the frames published by the ingestion thread & records their latencies
+ */
+void Benchmark::consumeFrames()
+{
+    CanSat::ReceivedFrame frame;
+    auto &worker = CanSat::IngestionWorker::instance();
+    while (worker.takeFrame(frame))
+    {
+        // Count frame
+        const auto now = Misc::SteadyClock::microseconds();
+        m_lastTakeTime = now;
+        ++m_framesTaken;
+
+        // Get packet count
+        qint64 packet = 0;
+        if (frame.valid && frame.type == CanSat::ReceivedFrame::Payload)
+            packet = frame.payload.packetCount;
+
+        else if (frame.valid && frame.type == CanSat::ReceivedFrame::Container)
+            packet = frame.container.packetCount;
+
+        else
+        {
+            ++m_invalidFrames;
+            continue;
+        }
+
+        // Record stage latencies
+        if (packet <= 0 || packet >= m_tableSize)
+            continue;
+
+        const auto sent = m_sendTimes[packet].load(std::memory_order_relaxed);
+        m_transport.record(frame.steadyTime - sent);
+        m_delivery.record(now - frame.steadyTime);
+        m_endToEnd.record(now - sent);
+    }
+}
+
+/**
+ * Processes events until the given @a condition is met, returns @c false if it is not
+ * met within @a timeout milliseconds
+ */
+bool Benchmark::waitFor(const std::function<bool()> &condition, const int timeout)
+{
+    QElapsedTimer timer;
+    timer.start();
+    while (!condition())
+    {
+        if (timer.elapsed() > timeout)
+            return false;
+
+        QCoreApplication::processEvents(QEventLoop::AllEvents, 10);
+        QThread::msleep(10);
+    }
+
+    return true;
+}
+
+/**
+ * Returns the total size of the files in the given directory & its subdirectories
+ */
+qint64 Benchmark::directorySize(const QString &path)
+{
+    qint64 size = 0;
+    QDirIterator it(path, QDir::Files, QDirIterator::Subdirectories);
+    while (it.hasNext())
+    {
+        it.next();
+        size += it.fileInfo().size();
+    }
+
+    return size;
+}
+
+/**
+ * Returns the count, mean & percentiles of the given @a histogram as a JSON object
+ */
+QJsonObject Benchmark::histogramJson(const Misc::LatencyHistogram &histogram)
+{
+    QJsonObject object;
+    object.insert("count", static_cast<qint64>(histogram.count()));
+    object.insert("min", histogram.min());
+    object.insert("mean", qRound64(histogram.mean()));
+    object.insert("p50", histogram.percentile(50));
+    object.insert("p90", histogram.percentile(90));
+    object.insert("p99", histogram.percentile(99));
+    object.insert("p999", histogram.percentile(99.9));
+    object.insert("max", histogram.max());
+    return object;
+}
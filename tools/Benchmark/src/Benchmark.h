@@ -0,0 +1,92 @@
+/*
+ * Copyright (c) 2022 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#pragma once
+
+#include <QThread>
+#include <QObject>
+#include <QVector>
+#include <QJsonObject>
+
+#include <atomic>
+#include <memory>
+#include <functional>
+
+#include <Feeder.h>
+#include <Misc/LatencyHistogram.h>
+
+/**
+ * @brief The Benchmark class
+ *
+ * Runs the ingestion path of the control panel (Serial Studio plugin, JSON framer,
+ * frame scanner, telemetry decoder, CSV & mission logs, telemetry history, frame
+ * queue) against a local TCP feeder & measures it for each scenario:
+ *
+ * - Sustained throughput (frames taken from the frame queue per second).
+ * - Latency percentiles of each stage: @c transport (feeder write to frame parsed by
+ *   the ingestion thread), @c delivery (frame parsed to frame taken from the queue)
+ *   & @c end_to_end.
+ * - CPU time of the process, peak resident set size & bytes written to the logs.
+ * - Correctness counters: invalid, dropped & missing frames.
+ *
+ * The frame queue is drained every millisecond (instead of at the 20 Hz rate of the
+ * user interface), so that @c delivery measures the ingestion path itself.
+ */
+class Benchmark : public QObject
+{
+    // clang-format off
+    Q_OBJECT
+    // clang-format on
+
+public:
+    explicit Benchmark(const QString &logPath);
+    ~Benchmark();
+
+    static QVector<Scenario> scenarios(const int duration);
+
+    bool start(const quint16 port);
+    QJsonObject run(const Scenario &scenario);
+
+private:
+    void consumeFrames();
+    bool waitFor(const std::function<bool()> &condition, const int timeout);
+
+    static qint64 directorySize(const QString &path);
+    static QJsonObject histogramJson(const Misc::LatencyHistogram &histogram);
+
+private:
+    QString m_logPath;
+    QThread m_feederThread;
+    Feeder *m_feeder;
+
+    std::atomic<bool> m_feederDone;
+    std::unique_ptr<std::atomic<qint64>[]> m_sendTimes;
+    qint64 m_tableSize;
+
+    qint64 m_framesTaken;
+    qint64 m_invalidFrames;
+    qint64 m_lastTakeTime;
+
+    Misc::LatencyHistogram m_transport;
+    Misc::LatencyHistogram m_delivery;
+    Misc::LatencyHistogram m_endToEnd;
+};
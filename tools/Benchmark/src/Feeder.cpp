@@ -0,0 +1,183 @@
+/*
+ * Copyright (c) 2022 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "Feeder.h"
+
+#include <QHostAddress>
+#include <Misc/SteadyClock.h>
+
+/*
+ * Characters used to generate garbage between frames (never frame delimiters)
+ */
+static constexpr char NOISE_CHARS[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789";
+
+/**
+ * Constructor function
+ */
+Feeder::Feeder()
+    : m_server(this)
+    , m_client(nullptr)
+    , m_timer(this)
+    , m_random(2022)
+    , m_connected(false)
+    , m_framesSent(0)
+    , m_sendTimes(nullptr)
+{
+    m_timer.setTimerType(Qt::PreciseTimer);
+    connect(&m_timer, &QTimer::timeout, this, &Feeder::sendBurst);
+    connect(&m_server, &QTcpServer::newConnection, this, &Feeder::onNewConnection);
+}
+
+/**
+ * Returns @c true if the control panel is connected to the feeder, can be called from
+ * any thread
+ */
+bool Feeder::isConnected() const
+{
+    return m_connected.load(std::memory_order_acquire);
+}
+
+/**
+ * Starts listening for the connection of the control panel on the given @a port
+ */
+bool Feeder::listen(const quint16 port)
+{
+    return m_server.listen(QHostAddress::LocalHost, port);
+}
+
+/**
+ * Starts sending the frames of the given @a scenario, the time at which each frame is
+ * sent is stored in the @a sendTimes table (which must have room for all the frames
+ * of the scenario, indexed by packet count)
+ */
+void Feeder::run(const Scenario &scenario, std::atomic<qint64> *sendTimes)
+{
+    m_scenario = scenario;
+    m_sendTimes = sendTimes;
+    m_framesSent = 0;
+
+    m_timer.setInterval(qMax(0, scenario.burstInterval));
+    m_timer.start();
+    sendBurst();
+}
+
+/**
+ * Sends the next burst of frames, the feeder stops once all the frames of the
+ * scenario have been sent
+ */
+void Feeder::sendBurst()
+{
+    // Get number of frames to send, send everything if bursts are not paced
+    auto count = m_scenario.frames - m_framesSent;
+    if (m_scenario.burstInterval > 0)
+        count = qMin<qint64>(count, m_scenario.burstSize);
+
+    // Build burst
+    QByteArray buffer;
+    for (qint64 i = 0; i < count; ++i)
+        appendFrame(buffer, m_framesSent + i + 1);
+
+    // Stamp & send frames
+    const auto time = Misc::SteadyClock::microseconds();
+    for (qint64 i = 0; i < count; ++i)
+        m_sendTimes[m_framesSent + i + 1].store(time, std::memory_order_relaxed);
+
+    write(buffer);
+    m_framesSent += count;
+
+    // Scenario finished
+    if (m_framesSent >= m_scenario.frames)
+    {
+        m_timer.stop();
+        if (m_client)
+            m_client->flush();
+
+        Q_EMIT finished();
+    }
+}
+
+/**
+ * Accepts the connection of the control panel, disabling Nagle's algorithm so that
+ * fragmented writes are not merged again
+ */
+void Feeder::onNewConnection()
+{
+    while (m_server.hasPendingConnections())
+    {
+        m_client = m_server.nextPendingConnection();
+        m_client->setSocketOption(QAbstractSocket::LowDelayOption, 1);
+        m_connected.store(true, std::memory_order_release);
+    }
+}
+
+/**
+ * Appends the frame with the given @a packet count, encoded as a Serial Studio JSON
+ * object, to the given @a buffer. Every tenth frame is a container frame, the rest
+ * are payload frames.
+ */
+void Feeder::appendFrame(QByteArray &buffer, const qint64 packet)
+{
+    // Add garbage
+    QByteArray data;
+    for (int i = 0; i < m_scenario.noiseBytes; ++i)
+        data.append(NOISE_CHARS[m_random.bounded(int(sizeof(NOISE_CHARS) - 1))]);
+
+    // clang-format off
+    if (packet % 10 == 0)
+        data.append("/*1099,12:00:00.00," + QByteArray::number(packet) +
+                    ",F,DESCENT,500.0,P,N,N,20.0,95.4,5.0,12:00:00,501.5,37.2431,"
+                    "-80.4222,9,1.00,2.00,CXON*/");
+    else
+        data.append("/*6026,12:00:00.00," + QByteArray::number(packet) +
+                    ",T,350.0,22.4,4.9,1.00,2.00,3.00,0.100,0.200,-9.810,0.400,0.300,"
+                    "0.210,12.5,STABILIZING*/");
+    // clang-format on
+
+    buffer.append("{\"data\":\"");
+    buffer.append(data.toBase64());
+    buffer.append("\"}");
+}
+
+/**
+ * Writes the given @a data to the control panel, in random fragments if the scenario
+ * requires it
+ */
+void Feeder::write(const QByteArray &data)
+{
+    if (!m_client)
+        return;
+
+    if (m_scenario.fragmentSize <= 0)
+    {
+        m_client->write(data);
+        return;
+    }
+
+    qsizetype offset = 0;
+    while (offset < data.size())
+    {
+        const auto size = m_random.bounded(1, m_scenario.fragmentSize + 1);
+        m_client->write(data.mid(offset, size));
+        m_client->flush();
+        offset += size;
+    }
+}
@@ -0,0 +1,96 @@
+/*
+ * Copyright (c) 2022 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#pragma once
+
+#include <QTimer>
+#include <QObject>
+#include <QTcpServer>
+#include <QTcpSocket>
+#include <QRandomGenerator>
+
+#include <atomic>
+
+/**
+ * @brief Traffic pattern of a benchmark scenario
+ *
+ * Frames are sent in bursts of @c burstSize frames, one burst every @c burstInterval
+ * milliseconds (all bursts at once if the interval is 0). Each TCP write can be split
+ * in random fragments of up to @c fragmentSize bytes, and @c noiseBytes garbage bytes
+ * can be inserted before each frame.
+ */
+struct Scenario
+{
+    QString name;
+    qint64 frames = 0;
+    int burstSize = 1;
+    int burstInterval = 0;
+    int fragmentSize = 0;
+    int noiseBytes = 0;
+};
+
+/**
+ * @brief The Feeder class
+ *
+ * Stand-in for the Serial Studio plugin server, running in its own thread. Payload
+ * frames (with a container frame every ten frames) are sent with the Serial Studio
+ * protocol, and the steady clock time at which each frame is written to the socket is
+ * stored in a send time table indexed by the packet count of the frame, so that the
+ * benchmark can compute per-frame latencies.
+ */
+class Feeder : public QObject
+{
+    // clang-format off
+    Q_OBJECT
+    // clang-format on
+
+Q_SIGNALS:
+    void finished();
+
+public:
+    Feeder();
+
+    bool isConnected() const;
+
+public Q_SLOTS:
+    bool listen(const quint16 port);
+    void run(const Scenario &scenario, std::atomic<qint64> *sendTimes);
+
+private Q_SLOTS:
+    void sendBurst();
+    void onNewConnection();
+
+private:
+    void appendFrame(QByteArray &buffer, const qint64 packet);
+    void write(const QByteArray &data);
+
+private:
+    QTcpServer m_server;
+    QTcpSocket *m_client;
+    QTimer m_timer;
+    QRandomGenerator m_random;
+    std::atomic<bool> m_connected;
+
+    Scenario m_scenario;
+    qint64 m_framesSent;
+    std::atomic<qint64> *m_sendTimes;
+};
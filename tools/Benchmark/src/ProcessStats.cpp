@@ -0,0 +1,85 @@
+/*
+ * Copyright (c) 2022 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "ProcessStats.h"
+
+#if defined(Q_OS_WIN)
+#    include <windows.h>
+#    include <psapi.h>
+#else
+#    include <sys/time.h>
+#    include <sys/resource.h>
+#endif
+
+/**
+ * Returns the CPU time (user + system) used by all the threads of the process, in
+ * microseconds
+ */
+qint64 ProcessStats::cpuTime()
+{
+#if defined(Q_OS_WIN)
+    FILETIME creation, exit, kernel, user;
+    if (!GetProcessTimes(GetCurrentProcess(), &creation, &exit, &kernel, &user))
+        return 0;
+
+    const auto toMicroseconds = [](const FILETIME &time) {
+        ULARGE_INTEGER value;
+        value.LowPart = time.dwLowDateTime;
+        value.HighPart = time.dwHighDateTime;
+        return static_cast<qint64>(value.QuadPart / 10);
+    };
+
+    return toMicroseconds(kernel) + toMicroseconds(user);
+#else
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0)
+        return 0;
+
+    const auto user = usage.ru_utime.tv_sec * 1000000LL + usage.ru_utime.tv_usec;
+    const auto system = usage.ru_stime.tv_sec * 1000000LL + usage.ru_stime.tv_usec;
+    return user + system;
+#endif
+}
+
+/**
+ * Returns the peak resident set size of the process, in KiB
+ */
+qint64 ProcessStats::peakMemory()
+{
+#if defined(Q_OS_WIN)
+    PROCESS_MEMORY_COUNTERS counters;
+    if (!GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)))
+        return 0;
+
+    return static_cast<qint64>(counters.PeakWorkingSetSize / 1024);
+#else
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0)
+        return 0;
+
+#    if defined(Q_OS_MACOS)
+    return usage.ru_maxrss / 1024;
+#    else
+    return usage.ru_maxrss;
+#    endif
+#endif
+}
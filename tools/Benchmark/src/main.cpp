@@ -0,0 +1,148 @@
+/*
+ * Copyright (c) 2022 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <QFile>
+#include <QDebug>
+#include <QDateTime>
+#include <QJsonArray>
+#include <QTemporaryDir>
+#include <QJsonDocument>
+#include <QCoreApplication>
+#include <QCommandLineParser>
+
+#include <cstdio>
+#include <algorithm>
+
+#include <Benchmark.h>
+
+/**
+ * @brief Entry-point function of the ingestion benchmark
+ *
+ * Runs the selected scenarios & writes their results as a JSON document to the
+ * standard output (or to the given output file). Log files are written to a temporary
+ * home directory, which is removed when the benchmark finishes.
+ *
+ * @param argc argument count
+ * @param argv argument data
+ *
+ * @return qApp exit code
+ */
+int main(int argc, char **argv)
+{
+    // Init. application, use its own settings so that user settings are not used
+    QCoreApplication app(argc, argv);
+    app.setApplicationName("CC2022-Benchmark");
+    app.setApplicationVersion("1.0.0");
+    app.setOrganizationName("CC2022-Benchmark");
+
+    // clang-format off
+    QCommandLineParser parser;
+    parser.addHelpOption();
+    parser.addVersionOption();
+    parser.setApplicationDescription("End-to-end ingestion benchmark of the CC2022 control panel");
+    parser.addOptions({
+        { "duration", "Duration of the paced scenarios in seconds (default 10).", "seconds", "10" },
+        { "scenario", "Comma-separated list of scenarios to run (default: all).", "names" },
+        { "port",     "TCP port of the feeder & the plugin (default 7777).", "port", "7777" },
+        { "output",   "Write the results to this file instead of the standard output.", "file" },
+        { "list",     "List the available scenarios & exit." },
+    });
+    parser.process(app);
+    // clang-format on
+
+    // Get scenarios
+    const auto duration = qMax(1, parser.value("duration").toInt());
+    auto scenarios = Benchmark::scenarios(duration);
+    if (parser.isSet("list"))
+    {
+        for (const auto &scenario : qAsConst(scenarios))
+            qInfo().noquote() << scenario.name;
+
+        return EXIT_SUCCESS;
+    }
+
+    if (parser.isSet("scenario"))
+    {
+        const auto names = parser.value("scenario").split(',', Qt::SkipEmptyParts);
+        scenarios.erase(std::remove_if(scenarios.begin(), scenarios.end(),
+                                       [&](const Scenario &scenario) {
+                                           return !names.contains(scenario.name);
+                                       }),
+                        scenarios.end());
+    }
+
+    if (scenarios.isEmpty())
+    {
+        qCritical().noquote() << "[Benchmark] No scenarios selected, see --list";
+        return EXIT_FAILURE;
+    }
+
+    // Redirect the log files of the ingestion thread to a temporary home directory
+    QTemporaryDir home;
+    if (!home.isValid())
+    {
+        qCritical().noquote() << "[Benchmark] Cannot create temporary directory";
+        return EXIT_FAILURE;
+    }
+
+    qputenv("HOME", home.path().toLocal8Bit());
+    qputenv("USERPROFILE", home.path().toLocal8Bit());
+
+    // Run scenarios
+    QJsonArray results;
+    {
+        Benchmark benchmark(home.path());
+        if (!benchmark.start(parser.value("port").toUShort()))
+            return EXIT_FAILURE;
+
+        for (const auto &scenario : qAsConst(scenarios))
+            results.append(benchmark.run(scenario));
+    }
+
+    // Build report
+    QJsonObject report;
+    report.insert("benchmark", "ingestion");
+    report.insert("qt_version", qVersion());
+    report.insert("timestamp", QDateTime::currentDateTimeUtc().toString(Qt::ISODate));
+    report.insert("duration_s", duration);
+    report.insert("scenarios", results);
+    const auto json = QJsonDocument(report).toJson(QJsonDocument::Indented);
+
+    // Write report
+    if (parser.isSet("output"))
+    {
+        QFile file(parser.value("output"));
+        if (!file.open(QFile::WriteOnly | QFile::Truncate))
+        {
+            qCritical().noquote() << "[Benchmark] Cannot write results:"
+                                  << file.errorString();
+            return EXIT_FAILURE;
+        }
+
+        file.write(json);
+    }
+
+    else
+        std::fwrite(json.constData(), 1, json.size(), stdout);
+
+    return EXIT_SUCCESS;
+}
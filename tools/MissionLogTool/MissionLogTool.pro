@@ -0,0 +1,35 @@
+#-------------------------------------------------------------------------------
+# Make options
+#-------------------------------------------------------------------------------
+
+MOC_DIR = moc
+OBJECTS_DIR = obj
+
+CONFIG += c++17
+CONFIG += console
+CONFIG -= app_bundle
+
+#-------------------------------------------------------------------------------
+# Qt configuration
+#-------------------------------------------------------------------------------
+
+TEMPLATE = app
+TARGET = MissionLogTool
+
+QT = core
+
+#-------------------------------------------------------------------------------
+# Import source code
+#-------------------------------------------------------------------------------
+
+INCLUDEPATH += $$PWD/src
+INCLUDEPATH += $$PWD/../../src
+
+HEADERS += \
+    ../../src/CanSat/MissionLog.h \
+    ../../src/Misc/LogWriter.h
+
+SOURCES += \
+    src/main.cpp \
+    ../../src/CanSat/MissionLog.cpp \
+    ../../src/Misc/LogWriter.cpp
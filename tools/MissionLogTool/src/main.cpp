@@ -0,0 +1,200 @@
+/*
+ * Copyright (c) 2022 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <QDir>
+#include <QFile>
+#include <QDebug>
+#include <QDateTime>
+#include <QFileInfo>
+#include <QCoreApplication>
+#include <QCommandLineParser>
+
+#include <CanSat/MissionLog.h>
+
+/**
+ * Prints the creation time, duration & number of records of each type of the log
+ */
+static int printInfo(CanSat::MissionLogReader &reader)
+{
+    // Count records
+    qint64 payload = 0, container = 0, unknown = 0;
+    qint64 first = 0, last = 0;
+    CanSat::MissionLogRecord record;
+    while (reader.readNext(record))
+    {
+        if (payload + container + unknown == 0)
+            first = record.timestamp;
+
+        last = record.timestamp;
+        if (record.type == CanSat::MissionLogRecord::PayloadFrame)
+            ++payload;
+        else if (record.type == CanSat::MissionLogRecord::ContainerFrame)
+            ++container;
+        else
+            ++unknown;
+    }
+
+    // Print log information
+    const auto created = QDateTime::fromMSecsSinceEpoch(reader.startTime());
+    qInfo().noquote() << "Created:         " << created.toString(Qt::ISODateWithMs);
+    qInfo().noquote() << "Duration:        " << (last - first) / 1000.0 << "s";
+    qInfo().noquote() << "Indexed seconds: " << reader.indexedSeconds();
+    qInfo().noquote() << "Payload frames:  " << payload;
+    qInfo().noquote() << "Container frames:" << container;
+    qInfo().noquote() << "Unknown frames:  " << unknown;
+    return EXIT_SUCCESS;
+}
+
+/**
+ * Converts the payload & container frames of the log back to CSV files. By default,
+ * the files are created next to the log (e.g. Mission_12-00-00_Payload.csv).
+ */
+static int exportCsv(CanSat::MissionLogReader &reader, const QString &logPath,
+                     const QCommandLineParser &parser)
+{
+    // Get file names
+    const QFileInfo info(logPath);
+    const auto base = info.absoluteDir().filePath(info.completeBaseName());
+    auto payloadCsv = parser.value("payload");
+    auto containerCsv = parser.value("container");
+    if (payloadCsv.isEmpty())
+        payloadCsv = base + "_Payload.csv";
+    if (containerCsv.isEmpty())
+        containerCsv = base + "_Container.csv";
+
+    // Export frames
+    const QList<QPair<CanSat::MissionLogRecord::Type, QString>> files
+        = { { CanSat::MissionLogRecord::PayloadFrame, payloadCsv },
+            { CanSat::MissionLogRecord::ContainerFrame, containerCsv } };
+    for (const auto &file : files)
+    {
+        if (!reader.exportCsv(file.second, file.first))
+        {
+            qCritical().noquote() << "[MissionLog] Cannot export" << file.second << ":"
+                                  << reader.errorString();
+            return EXIT_FAILURE;
+        }
+
+        qInfo().noquote() << "[MissionLog] Exported" << file.second;
+    }
+
+    return EXIT_SUCCESS;
+}
+
+/**
+ * Writes the frames received from the given mission second onwards, one frame per
+ * line, to the output file or to the standard output. The output can be replayed
+ * with the Serial Studio stand-in server (SerialStudioStub --replay).
+ */
+static int replay(CanSat::MissionLogReader &reader, const QCommandLineParser &parser)
+{
+    // Open output
+    const auto fileName = parser.value("output");
+    QFile output(fileName);
+    const auto opened = fileName.isEmpty() ? output.open(stdout, QFile::WriteOnly)
+                                           : output.open(QFile::WriteOnly);
+    if (!opened)
+    {
+        qCritical().noquote() << "[MissionLog] Cannot write output:"
+                              << output.errorString();
+        return EXIT_FAILURE;
+    }
+
+    // Jump to the requested second of the mission
+    const auto second = qMax<qint64>(0, parser.value("from").toLongLong());
+    if (!reader.seekToMissionSecond(second))
+    {
+        qCritical().noquote() << "[MissionLog] Cannot seek to second" << second;
+        return EXIT_FAILURE;
+    }
+
+    // Write frames
+    CanSat::MissionLogRecord record;
+    while (reader.readNext(record))
+    {
+        if (record.type == CanSat::MissionLogRecord::UnknownFrame)
+            continue;
+
+        output.write(record.data.data(), record.data.size());
+        output.write("\n", 1);
+    }
+
+    return EXIT_SUCCESS;
+}
+
+/**
+ * @brief Entry-point function of the mission log tool
+ *
+ * Shows information about binary mission logs, converts them back to CSV files and
+ * extracts the frames received from any second of the mission for replay.
+ *
+ * @param argc argument count
+ * @param argv argument data
+ *
+ * @return qApp exit code
+ */
+int main(int argc, char **argv)
+{
+    // Init. application
+    QCoreApplication app(argc, argv);
+    app.setApplicationName("MissionLogTool");
+    app.setApplicationVersion("1.0.0");
+
+    // clang-format off
+    QCommandLineParser parser;
+    parser.addHelpOption();
+    parser.addVersionOption();
+    parser.setApplicationDescription("Mission log tool for the CC2022 control panel");
+    parser.addPositionalArgument("command", "info, export or replay.");
+    parser.addPositionalArgument("log", "Mission log file (.cclog).");
+    parser.addOptions({
+        { "payload",   "Payload CSV file written by export.", "file" },
+        { "container", "Container CSV file written by export.", "file" },
+        { "from",      "Mission second from which replay starts (default 0).", "second", "0" },
+        { "output",    "File written by replay (default: standard output).", "file" },
+    });
+    parser.process(app);
+    // clang-format on
+
+    // Validate arguments
+    const auto args = parser.positionalArguments();
+    const auto command = args.value(0);
+    if (args.size() != 2 || !QStringList({ "info", "export", "replay" }).contains(command))
+        parser.showHelp(EXIT_FAILURE);
+
+    // Open log
+    CanSat::MissionLogReader reader;
+    if (!reader.open(args.at(1)))
+    {
+        qCritical().noquote() << "[MissionLog] Cannot open" << args.at(1) << ":"
+                              << reader.errorString();
+        return EXIT_FAILURE;
+    }
+
+    // Run command
+    if (command == "info")
+        return printInfo(reader);
+    else if (command == "export")
+        return exportCsv(reader, args.at(1), parser);
+    else
+        return replay(reader, parser);
+}
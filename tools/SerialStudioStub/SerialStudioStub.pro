@@ -0,0 +1,37 @@
+#-------------------------------------------------------------------------------
+# Make options
+#-------------------------------------------------------------------------------
+
+MOC_DIR = moc
+OBJECTS_DIR = obj
+
+CONFIG += c++17
+CONFIG += console
+CONFIG -= app_bundle
+
+#-------------------------------------------------------------------------------
+# Qt configuration
+#-------------------------------------------------------------------------------
+
+TEMPLATE = app
+TARGET = SerialStudioStub
+
+QT = core network
+
+#-------------------------------------------------------------------------------
+# Import source code
+#-------------------------------------------------------------------------------
+
+INCLUDEPATH += $$PWD/src
+INCLUDEPATH += $$PWD/../../src
+
+HEADERS += \
+    src/StubServer.h \
+    src/TelemetrySource.h \
+    ../../src/XBee/FrameDecoder.h
+
+SOURCES += \
+    src/main.cpp \
+    src/StubServer.cpp \
+    src/TelemetrySource.cpp \
+    ../../src/XBee/FrameDecoder.cpp
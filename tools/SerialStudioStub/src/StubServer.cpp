@@ -0,0 +1,440 @@
+/*
+ * Copyright (c) 2022 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "StubServer.h"
+
+#include <QDebug>
+#include <QtMath>
+#include <QtEndian>
+#include <QCoreApplication>
+
+/*
+ * Maximum number of frames sent in a single timer tick, used to avoid huge bursts if
+ * the event loop was blocked for a long time
+ */
+static constexpr qint64 MAX_BURST = 10000;
+
+/*
+ * Characters used to generate garbage between frames, chosen so that garbage never
+ * contains frame delimiters or XBee control bytes
+ */
+static constexpr char NOISE_CHARS[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789";
+
+/*
+ * Size of the header of a transmit request frame: API identifier, frame ID, 64-bit
+ * & 16-bit addresses, broadcast radius & options
+ */
+static constexpr qsizetype TRANSMIT_REQUEST_HEADER = 14;
+
+/*
+ * Source addresses of the receive packet frames (the XBee of the CanSat container) &
+ * receive options (packet acknowledged)
+ */
+static constexpr quint64 SOURCE_ADDRESS_64 = 0x0013A2004183A626;
+static constexpr quint16 SOURCE_ADDRESS_16 = 0xFFFE;
+static constexpr quint8 RECEIVE_OPTIONS = 0x01;
+
+/**
+ * Constructor function
+ */
+StubServer::StubServer(const Options &options)
+    : m_options(options)
+    , m_client(nullptr)
+    , m_random(options.seed)
+    , m_framesSent(0)
+    , m_bytesSent(0)
+    , m_writes(0)
+    , m_commands(0)
+    , m_lastFramesSent(0)
+{
+    // Server signals/slots
+    connect(&m_server, &QTcpServer::newConnection, this, &StubServer::onNewConnection);
+
+    // Pace frames with a precise timer, ticking at least once per millisecond for high
+    // rates. Deadlines are computed from the connection time, so they do not drift.
+    const auto interval = qBound(1, qFloor(1000 / qMax(options.rate, 0.001)), 1000);
+    m_timer.setInterval(interval);
+    m_timer.setTimerType(Qt::PreciseTimer);
+    connect(&m_timer, &QTimer::timeout, this, &StubServer::sendFrames);
+
+    // Print statistics every second
+    m_statisticsTimer.setInterval(1000);
+    connect(&m_statisticsTimer, &QTimer::timeout, this, &StubServer::printStatistics);
+}
+
+/**
+ * Loads the recording to replay, opens the capture file & starts listening for
+ * connections. Returns @c false on failure, see @c errorString() for details.
+ */
+bool StubServer::start()
+{
+    // Load recording
+    if (!m_options.replayFile.isEmpty())
+    {
+        if (!m_source.loadRecording(m_options.replayFile))
+        {
+            m_errorString = m_options.replayFile + ": " + m_source.errorString();
+            return false;
+        }
+
+        qInfo().noquote() << "[Stub] Replaying" << m_source.recordedFrames()
+                          << "frames from" << m_options.replayFile;
+    }
+
+    // Configure frame source & decoder
+    m_source.setPayloadFrames(m_options.payloadFrames);
+    m_decoder.setEscaped(m_options.escaped);
+
+    // Open capture file
+    if (!m_options.captureFile.isEmpty())
+    {
+        m_capture.setFileName(m_options.captureFile);
+        if (!m_capture.open(QFile::WriteOnly | QFile::Truncate | QFile::Text))
+        {
+            m_errorString = m_options.captureFile + ": " + m_capture.errorString();
+            return false;
+        }
+
+        m_capture.write("TIME_MS,FRAME_ID,COMMAND\n");
+    }
+
+    // Start server
+    if (!m_server.listen(QHostAddress::LocalHost, m_options.port))
+    {
+        m_errorString = m_server.errorString();
+        return false;
+    }
+
+    qInfo().noquote() << "[Stub] Listening on port" << m_options.port;
+    return true;
+}
+
+/**
+ * Returns the reason why the server could not be started
+ */
+QString StubServer::errorString() const
+{
+    return m_errorString;
+}
+
+/**
+ * Sends the frames whose deadlines have passed to the connected client. If the
+ * requested number of frames has been sent, statistics are printed & the application
+ * quits after a grace period, so that the last commands can still be captured.
+ */
+void StubServer::sendFrames()
+{
+    // No client connected
+    if (!m_client)
+        return;
+
+    // Get number of frames that should have been sent by now
+    const auto elapsed = m_clock.nsecsElapsed() / 1e9;
+    auto due = static_cast<qint64>(elapsed * m_options.rate) + 1 - m_framesSent;
+    if (m_options.count > 0)
+        due = qMin(due, m_options.count - m_framesSent);
+
+    due = qMin(due, MAX_BURST);
+    if (due <= 0)
+        return;
+
+    // Generate frames, preceded by garbage if needed
+    QList<QByteArray> pieces;
+    pieces.reserve(due);
+    for (qint64 i = 0; i < due; ++i)
+    {
+        QByteArray piece;
+        for (int j = 0; j < m_options.noiseBytes; ++j)
+            piece.append(NOISE_CHARS[m_random.bounded(int(sizeof(NOISE_CHARS) - 1))]);
+
+        if (m_options.api)
+        {
+            QByteArray telemetry;
+            m_source.appendNext(telemetry);
+            piece.append(receivePacket(telemetry));
+        }
+
+        else
+            m_source.appendNext(piece);
+
+        pieces.append(piece);
+    }
+
+    // Split serial data in fixed-size chunks that straddle frame boundaries
+    if (m_options.chunkSize > 0)
+    {
+        const auto stream = pieces.join();
+        pieces.clear();
+        for (qsizetype i = 0; i < stream.size(); i += m_options.chunkSize)
+            pieces.append(stream.mid(i, m_options.chunkSize));
+    }
+
+    // Send data
+    m_framesSent += due;
+    writeMessages(pieces);
+
+    // Stop when all frames have been sent
+    if (m_options.count > 0 && m_framesSent >= m_options.count)
+    {
+        m_timer.stop();
+        printStatistics();
+        qInfo().noquote() << "[Stub] All frames sent, exiting in 1 second";
+        QTimer::singleShot(1000, qApp, &QCoreApplication::quit);
+    }
+}
+
+/**
+ * Prints the send rate & totals of the current connection
+ */
+void StubServer::printStatistics()
+{
+    qInfo().noquote() << QString("[Stub] %1 frames/s, %2 frames, %3 KiB in %4 writes, "
+                                 "%5 commands received")
+                             .arg(m_framesSent - m_lastFramesSent)
+                             .arg(m_framesSent)
+                             .arg(m_bytesSent / 1024)
+                             .arg(m_writes)
+                             .arg(m_commands);
+
+    m_lastFramesSent = m_framesSent;
+}
+
+/**
+ * Accepts the connection of a control panel. Only one client is served at a time,
+ * a new connection replaces the previous one.
+ */
+void StubServer::onNewConnection()
+{
+    while (m_server.hasPendingConnections())
+    {
+        // Replace previous client
+        if (m_client)
+        {
+            m_client->disconnect(this);
+            m_client->abort();
+            m_client->deleteLater();
+        }
+
+        // Register client, disable Nagle's algorithm so that writes are not merged
+        m_client = m_server.nextPendingConnection();
+        m_client->setSocketOption(QAbstractSocket::LowDelayOption, 1);
+        connect(m_client, &QTcpSocket::readyRead, this, &StubServer::onClientReadyRead);
+        connect(m_client, &QTcpSocket::disconnected, this,
+                &StubServer::onClientDisconnected);
+
+        // Reset pacing & statistics
+        m_framesSent = 0;
+        m_bytesSent = 0;
+        m_writes = 0;
+        m_commands = 0;
+        m_lastFramesSent = 0;
+        m_decoder.clear();
+        m_clock.start();
+        m_timer.start();
+        m_statisticsTimer.start();
+
+        qInfo().noquote() << "[Stub] Control panel connected";
+    }
+}
+
+/**
+ * Decodes the XBee frames sent by the control panel
+ */
+void StubServer::onClientReadyRead()
+{
+    m_decoder.append(m_client->readAll());
+
+    QByteArrayView frame;
+    while (m_decoder.next(frame))
+    {
+        if (static_cast<quint8>(frame.at(0)) == XBee::TransmitRequest)
+            processTransmitRequest(frame);
+    }
+}
+
+/**
+ * Stops sending frames when the control panel disconnects
+ */
+void StubServer::onClientDisconnected()
+{
+    m_timer.stop();
+    m_statisticsTimer.stop();
+    printStatistics();
+
+    m_client->deleteLater();
+    m_client = nullptr;
+
+    qInfo().noquote() << "[Stub] Control panel disconnected";
+}
+
+/**
+ * Wraps the given @a data in an XBee API frame (start delimiter, length, data &
+ * checksum), escaping it if the server runs in API mode 2
+ */
+QByteArray StubServer::apiFrame(QByteArrayView data) const
+{
+    // Build frame
+    QByteArray frame;
+    frame.reserve(data.size() + 4);
+    frame.append(char(0x7E));
+    frame.append(char(data.size() >> 8));
+    frame.append(char(data.size() & 0xFF));
+    frame.append(data.data(), data.size());
+
+    // Add checksum
+    quint8 sum = 0;
+    for (const auto byte : data)
+        sum += static_cast<quint8>(byte);
+
+    frame.append(char(0xFF - sum));
+
+    // Escape frame (except for the start delimiter)
+    if (!m_options.escaped)
+        return frame;
+
+    QByteArray escaped;
+    escaped.reserve(frame.size() * 2);
+    escaped.append(frame.at(0));
+    for (qsizetype i = 1; i < frame.size(); ++i)
+    {
+        const auto byte = static_cast<quint8>(frame.at(i));
+        if (byte == 0x7E || byte == 0x7D || byte == 0x11 || byte == 0x13)
+        {
+            escaped.append(char(0x7D));
+            escaped.append(char(byte ^ 0x20));
+        }
+
+        else
+            escaped.append(char(byte));
+    }
+
+    return escaped;
+}
+
+/**
+ * Wraps the given @a telemetry in a receive packet (0x90) frame sent by the XBee of
+ * the container, as received by the ground station XBee in API mode
+ */
+QByteArray StubServer::receivePacket(QByteArrayView telemetry) const
+{
+    QByteArray data(XBee::RECEIVE_PACKET_HEADER_SIZE, '\0');
+    data[0] = char(XBee::ReceivePacket);
+    qToBigEndian<quint64>(SOURCE_ADDRESS_64, data.data() + 1);
+    qToBigEndian<quint16>(SOURCE_ADDRESS_16, data.data() + 9);
+    data[11] = char(RECEIVE_OPTIONS);
+    data.append(telemetry.data(), telemetry.size());
+    return apiFrame(data);
+}
+
+/**
+ * Captures the command of a transmit request (0x10) frame, uses it as the command
+ * echo of the synthetic container frames & acknowledges it in API mode
+ */
+void StubServer::processTransmitRequest(QByteArrayView frame)
+{
+    // Validate frame
+    if (frame.size() < TRANSMIT_REQUEST_HEADER)
+        return;
+
+    // Get frame ID & command
+    ++m_commands;
+    const auto frameId = static_cast<quint8>(frame.at(1));
+    const auto command = QString::fromUtf8(frame.sliced(TRANSMIT_REQUEST_HEADER));
+    qInfo().noquote() << "[Stub] Command" << frameId << command;
+
+    // Capture command
+    if (m_capture.isOpen())
+    {
+        m_capture.write(QString("%1,%2,\"%3\"\n")
+                            .arg(m_clock.elapsed())
+                            .arg(frameId)
+                            .arg(command)
+                            .toUtf8());
+        m_capture.flush();
+    }
+
+    // Echo command (e.g. CMD,1099,CX,ON; is echoed as CXON)
+    auto fields = command.trimmed().remove(';').split(',');
+    if (fields.count() >= 3 && fields.first() == "CMD")
+        m_source.setCommandEcho(fields.mid(2).join(QString()).toUtf8());
+
+    // Acknowledge transmit request
+    if (m_options.api && frameId != 0)
+    {
+        const char status[] = { char(XBee::TransmitStatus), char(frameId), char(0xFF),
+                                char(0xFE), 0, 0, 0 };
+        writeMessages({ apiFrame(QByteArrayView(status, sizeof(status))) });
+    }
+}
+
+/**
+ * Writes the given @a data to the client, fragmented into randomly sized writes if
+ * requested
+ */
+void StubServer::writeData(const QByteArray &data)
+{
+    // Write all data at once
+    m_bytesSent += data.size();
+    if (m_options.fragmentSize <= 0)
+    {
+        m_client->write(data);
+        ++m_writes;
+        return;
+    }
+
+    // Write fragments of 1 to fragmentSize bytes, each one flushed separately
+    qsizetype offset = 0;
+    while (offset < data.size())
+    {
+        const auto size = m_random.bounded(1, m_options.fragmentSize + 1);
+        m_client->write(data.mid(offset, size));
+        m_client->flush();
+        offset += size;
+        ++m_writes;
+    }
+}
+
+/**
+ * Encodes each one of the given @a messages as a Serial Studio JSON object & writes
+ * them to the client, merging several objects into each write if requested
+ */
+void StubServer::writeMessages(const QList<QByteArray> &messages)
+{
+    QByteArray buffer;
+    int merged = 0;
+    for (const auto &message : messages)
+    {
+        buffer.append("{\"data\":\"");
+        buffer.append(message.toBase64());
+        buffer.append("\"}");
+
+        if (++merged >= qMax(1, m_options.mergeCount))
+        {
+            writeData(buffer);
+            buffer.clear();
+            merged = 0;
+        }
+    }
+
+    if (!buffer.isEmpty())
+        writeData(buffer);
+}
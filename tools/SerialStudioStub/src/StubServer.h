@@ -0,0 +1,118 @@
+/*
+ * Copyright (c) 2022 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#pragma once
+
+#include <QFile>
+#include <QTimer>
+#include <QObject>
+#include <QTcpServer>
+#include <QTcpSocket>
+#include <QElapsedTimer>
+#include <QRandomGenerator>
+
+#include <TelemetrySource.h>
+#include <XBee/FrameDecoder.h>
+
+/**
+ * @brief The StubServer class
+ *
+ * Stand-in for the plugin server of Serial Studio (TCP port 7777). Telemetry frames
+ * are sent to the connected control panel with the same protocol as Serial Studio:
+ * JSON objects whose @c data value contains the received serial data, encoded in
+ * base64.
+ *
+ * Frames are sent at a fixed rate with absolute deadlines, from 1 Hz up to thousands
+ * of frames per second. The serial data can be split into chunks that straddle frame
+ * boundaries, several JSON objects can be merged into one TCP write, and each write
+ * can be fragmented into randomly sized pieces. Random garbage bytes can also be
+ * inserted between frames.
+ *
+ * The XBee transmit requests sent by the control panel are decoded, printed & written
+ * to an optional capture file. In API mode, telemetry is wrapped in receive packet
+ * (0x90) frames and every transmit request is acknowledged with a transmit status
+ * (0x8B) frame, like a local XBee radio would do.
+ */
+class StubServer : public QObject
+{
+    // clang-format off
+    Q_OBJECT
+    // clang-format on
+
+public:
+    struct Options
+    {
+        quint16 port = 7777;
+        double rate = 1;
+        qint64 count = 0;
+        int payloadFrames = 1;
+        int chunkSize = 0;
+        int mergeCount = 1;
+        int fragmentSize = 0;
+        int noiseBytes = 0;
+        bool api = false;
+        bool escaped = false;
+        quint32 seed = 0;
+        QString replayFile;
+        QString captureFile;
+    };
+
+    explicit StubServer(const Options &options);
+
+    bool start();
+    QString errorString() const;
+
+private Q_SLOTS:
+    void sendFrames();
+    void printStatistics();
+    void onNewConnection();
+    void onClientReadyRead();
+    void onClientDisconnected();
+
+private:
+    QByteArray apiFrame(QByteArrayView data) const;
+    QByteArray receivePacket(QByteArrayView telemetry) const;
+    void processTransmitRequest(QByteArrayView frame);
+    void writeData(const QByteArray &data);
+    void writeMessages(const QList<QByteArray> &messages);
+
+private:
+    Options m_options;
+    QString m_errorString;
+
+    QTcpServer m_server;
+    QTcpSocket *m_client;
+    QTimer m_timer;
+    QTimer m_statisticsTimer;
+    QElapsedTimer m_clock;
+    QRandomGenerator m_random;
+
+    QFile m_capture;
+    TelemetrySource m_source;
+    XBee::FrameDecoder m_decoder;
+
+    qint64 m_framesSent;
+    qint64 m_bytesSent;
+    qint64 m_writes;
+    qint64 m_commands;
+    qint64 m_lastFramesSent;
+};
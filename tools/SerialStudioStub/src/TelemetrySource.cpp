@@ -0,0 +1,210 @@
+/*
+ * Copyright (c) 2022 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "TelemetrySource.h"
+
+#include <QFile>
+#include <QtMath>
+#include <QDateTime>
+
+/*
+ * Number of container frames of a synthetic flight (ascent, descent & landing)
+ */
+static constexpr quint32 FLIGHT_FRAMES = 300;
+
+/**
+ * Returns the current UTC time in the hh:mm:ss.ss format used by the mission clock
+ */
+static QByteArray missionTime()
+{
+    auto time = QDateTime::currentDateTimeUtc().time().toString("hh:mm:ss.zzz");
+    time.chop(1);
+    return time.toLatin1();
+}
+
+/**
+ * Constructor function
+ */
+TelemetrySource::TelemetrySource()
+    : m_recordingIndex(0)
+    , m_payloadFrames(1)
+    , m_payloadIndex(0)
+    , m_containerPackets(0)
+    , m_payloadPackets(0)
+    , m_commandEcho("CXON")
+{
+}
+
+/**
+ * Returns the reason why the last recording could not be loaded
+ */
+QString TelemetrySource::errorString() const
+{
+    return m_errorString;
+}
+
+/**
+ * Returns the number of frames of the loaded recording, or 0 if frames are synthesized
+ */
+qsizetype TelemetrySource::recordedFrames() const
+{
+    return m_recording.count();
+}
+
+/**
+ * Loads the frames to replay from the given text file. Every line that contains a
+ * delimited frame, or that starts with a team ID (e.g. the rows of the CSV files
+ * written by the control panel), is a frame; other lines are ignored.
+ */
+bool TelemetrySource::loadRecording(const QString &fileName)
+{
+    // Open file
+    QFile file(fileName);
+    if (!file.open(QFile::ReadOnly))
+    {
+        m_errorString = file.errorString();
+        return false;
+    }
+
+    // Read frames
+    m_recording.clear();
+    m_recordingIndex = 0;
+    while (!file.atEnd())
+    {
+        const auto line = file.readLine().trimmed();
+        if (line.startsWith("/*") && line.endsWith("*/"))
+            m_recording.append(line);
+        else if (line.startsWith("1099,") || line.startsWith("6026,"))
+            m_recording.append("/*" + line + "*/");
+    }
+
+    // Validate recording
+    if (m_recording.isEmpty())
+    {
+        m_errorString = QStringLiteral("The file does not contain telemetry frames");
+        return false;
+    }
+
+    return true;
+}
+
+/**
+ * Sets the number of synthetic payload frames sent after each container frame
+ */
+void TelemetrySource::setPayloadFrames(const int frames)
+{
+    m_payloadFrames = qMax(0, frames);
+}
+
+/**
+ * Sets the command echo field of the synthetic container frames
+ */
+void TelemetrySource::setCommandEcho(const QByteArray &echo)
+{
+    m_commandEcho = echo.left(32);
+}
+
+/**
+ * Appends the next frame to the given @a output buffer
+ */
+void TelemetrySource::appendNext(QByteArray &output)
+{
+    // Replay recorded frames
+    if (!m_recording.isEmpty())
+    {
+        output.append(m_recording.at(m_recordingIndex));
+        m_recordingIndex = (m_recordingIndex + 1) % m_recording.count();
+        return;
+    }
+
+    // Synthesize a container frame followed by the payload frames
+    if (m_payloadIndex == 0)
+        appendContainerFrame(output);
+    else
+        appendPayloadFrame(output);
+
+    m_payloadIndex = (m_payloadIndex + 1) % (m_payloadFrames + 1);
+}
+
+/**
+ * Appends a synthetic container frame to the given @a output buffer
+ */
+void TelemetrySource::appendContainerFrame(QByteArray &output)
+{
+    // Get flight phase
+    const auto t = m_containerPackets % FLIGHT_FRAMES;
+    const auto ascent = t < 100;
+    const auto altitude = ascent ? t * 7.0 : qMax(0.0, 700.0 - (t - 100) * 5.0);
+    const auto landed = !ascent && altitude <= 0;
+
+    // Build frame
+    ++m_containerPackets;
+    output.append("/*1099,");
+    output.append(missionTime());
+    output.append(',').append(QByteArray::number(m_containerPackets));
+    output.append(",F,");
+    output.append(ascent ? "ASCENT" : (landed ? "LANDED" : "DESCENT"));
+    output.append(',').append(QByteArray::number(altitude, 'f', 1));
+    output.append(ascent ? ",N" : ",P");
+    output.append(altitude < 400 && !ascent ? ",C" : ",N");
+    output.append(landed ? ",M" : ",N");
+    output.append(',').append(QByteArray::number(25.0 - altitude / 150.0, 'f', 1));
+    output.append(',').append(QByteArray::number(101.3 - altitude / 84.0, 'f', 1));
+    output.append(",5.0,");
+    output.append(missionTime().left(8));
+    output.append(',').append(QByteArray::number(altitude + 1.5, 'f', 1));
+    output.append(",37.2431,-80.4222,");
+    output.append(QByteArray::number(8 + m_containerPackets % 4));
+    output.append(',').append(QByteArray::number(qSin(t / 10.0) * 5.0, 'f', 2));
+    output.append(',').append(QByteArray::number(qCos(t / 10.0) * 5.0, 'f', 2));
+    output.append(',').append(m_commandEcho);
+    output.append("*/");
+}
+
+/**
+ * Appends a synthetic payload frame to the given @a output buffer
+ */
+void TelemetrySource::appendPayloadFrame(QByteArray &output)
+{
+    // Get rotation angle
+    ++m_payloadPackets;
+    const auto angle = m_payloadPackets / 20.0;
+
+    // Build frame
+    output.append("/*6026,");
+    output.append(missionTime());
+    output.append(',').append(QByteArray::number(m_payloadPackets));
+    output.append(",T,");
+    output.append(QByteArray::number(350.0 + qSin(angle) * 10.0, 'f', 1));
+    output.append(",22.4,4.9");
+    output.append(',').append(QByteArray::number(qSin(angle) * 30.0, 'f', 2));
+    output.append(',').append(QByteArray::number(qCos(angle) * 30.0, 'f', 2));
+    output.append(",120.00");
+    output.append(',').append(QByteArray::number(qSin(angle) * 0.2, 'f', 3));
+    output.append(',').append(QByteArray::number(qCos(angle) * 0.2, 'f', 3));
+    output.append(",-9.810");
+    output.append(',').append(QByteArray::number(qCos(angle) * 0.4, 'f', 3));
+    output.append(',').append(QByteArray::number(qSin(angle) * 0.4, 'f', 3));
+    output.append(",0.210");
+    output.append(',').append(QByteArray::number(qAbs(qSin(angle)) * 15.0, 'f', 1));
+    output.append(",STABILIZING*/");
+}
@@ -0,0 +1,67 @@
+/*
+ * Copyright (c) 2022 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#pragma once
+
+#include <QVector>
+#include <QByteArray>
+
+/**
+ * @brief The TelemetrySource class
+ *
+ * Generates the telemetry frames (delimited by slash-asterisk & asterisk-slash) sent
+ * by the stand-in server. Frames are either replayed from a recording, in a loop, or
+ * synthesized: a container frame (team ID 1099) followed by a configurable number of
+ * payload frames (team ID 6026), with a simple ascent & descent altitude profile.
+ *
+ * Synthetic container frames echo the last command received from the control panel,
+ * so that command round-trip latency can be measured without a radio.
+ */
+class TelemetrySource
+{
+public:
+    TelemetrySource();
+
+    QString errorString() const;
+    qsizetype recordedFrames() const;
+
+    bool loadRecording(const QString &fileName);
+    void setPayloadFrames(const int frames);
+    void setCommandEcho(const QByteArray &echo);
+
+    void appendNext(QByteArray &output);
+
+private:
+    void appendContainerFrame(QByteArray &output);
+    void appendPayloadFrame(QByteArray &output);
+
+private:
+    QString m_errorString;
+    QVector<QByteArray> m_recording;
+    qsizetype m_recordingIndex;
+
+    int m_payloadFrames;
+    int m_payloadIndex;
+    quint32 m_containerPackets;
+    quint32 m_payloadPackets;
+    QByteArray m_commandEcho;
+};
@@ -0,0 +1,93 @@
+/*
+ * Copyright (c) 2022 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <QDebug>
+#include <QCoreApplication>
+#include <QCommandLineParser>
+
+#include <StubServer.h>
+
+/**
+ * @brief Entry-point function of the Serial Studio stand-in server
+ *
+ * @param argc argument count
+ * @param argv argument data
+ *
+ * @return qApp exit code
+ */
+int main(int argc, char **argv)
+{
+    // Init. application
+    QCoreApplication app(argc, argv);
+    app.setApplicationName("SerialStudioStub");
+    app.setApplicationVersion("1.0.0");
+
+    // clang-format off
+    QCommandLineParser parser;
+    parser.addHelpOption();
+    parser.addVersionOption();
+    parser.setApplicationDescription("Serial Studio stand-in server for the CC2022 control panel");
+    parser.addOptions({
+        { "port",     "TCP port of the plugin server (default 7777).", "port", "7777" },
+        { "rate",     "Frames sent per second (default 1).", "hz", "1" },
+        { "count",    "Quit after sending this many frames (default: never).", "frames", "0" },
+        { "payloads", "Synthetic payload frames per container frame (default 1).", "frames", "1" },
+        { "replay",   "Replay the frames of a recording (one frame per line).", "file" },
+        { "chunk",    "Split serial data in chunks of this size (default: one chunk per frame).", "bytes", "0" },
+        { "merge",    "JSON objects merged into each TCP write (default 1).", "count", "1" },
+        { "fragment", "Split TCP writes in random pieces of up to this size.", "bytes", "0" },
+        { "noise",    "Garbage bytes inserted before each frame.", "bytes", "0" },
+        { "api",      "Wrap telemetry in XBee receive packets & acknowledge commands." },
+        { "escaped",  "Use XBee API mode 2 (escaped) frames." },
+        { "capture",  "Write the commands sent by the control panel to a CSV file.", "file" },
+        { "seed",     "Seed of the random generator (default 0).", "seed", "0" },
+    });
+    parser.process(app);
+    // clang-format on
+
+    // Read options
+    StubServer::Options options;
+    options.port = parser.value("port").toUShort();
+    options.rate = qMax(0.001, parser.value("rate").toDouble());
+    options.count = parser.value("count").toLongLong();
+    options.payloadFrames = parser.value("payloads").toInt();
+    options.chunkSize = parser.value("chunk").toInt();
+    options.mergeCount = parser.value("merge").toInt();
+    options.fragmentSize = parser.value("fragment").toInt();
+    options.noiseBytes = parser.value("noise").toInt();
+    options.api = parser.isSet("api") || parser.isSet("escaped");
+    options.escaped = parser.isSet("escaped");
+    options.seed = parser.value("seed").toUInt();
+    options.replayFile = parser.value("replay");
+    options.captureFile = parser.value("capture");
+
+    // Start server
+    StubServer server(options);
+    if (!server.start())
+    {
+        qCritical().noquote() << "[Stub] Cannot start server:" << server.errorString();
+        return EXIT_FAILURE;
+    }
+
+    // Enter application event loop
+    return app.exec();
+}